@@ -0,0 +1,31 @@
+/**
+ * Benchmarks dos operadores de crossover criados pela CrossoverFabric com
+ * cromossomos de 100 a 10000 genes.
+ */
+
+#include <memory>
+#include <benchmark/benchmark.h>
+#include <core/ga/crossover_fabric.h>
+#include <core/ga/random.h>
+
+/**
+ * Argumentos: [0] ID do crossover (ver CrossoverFabric::create),
+ *             [1] tamanho do cromossomo */
+static void BM_Crossover(benchmark::State& state) {
+  const uint crossID = state.range(0);
+  const uint chromsize = state.range(1);
+  std::unique_ptr<eoQuadOp<Chrom>> cross(CrossoverFabric::create(crossID));
+  Chrom a = Random<Chrom>::uniform_chromosome(chromsize);
+  Chrom b = Random<Chrom>::uniform_chromosome(chromsize);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize((*cross)(a, b));
+  }
+  state.SetLabel(CrossoverFabric::name(crossID));
+  state.SetItemsProcessed(state.iterations() * chromsize);
+}
+
+BENCHMARK(BM_Crossover)
+  ->ArgNames({"crossover", "chromsize"})
+  ->ArgsProduct({{0, 1, 2, 4, 8, 100, 101, 102, 201, 204},
+                 {100, 1000, 10000}});
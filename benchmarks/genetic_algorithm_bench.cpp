@@ -0,0 +1,132 @@
+/**
+ * Benchmark de uma geração completa do GeneticAlgorithm (seleção, crossover,
+ * mutação, avaliação e elitismo) na mochila multidimensional, com a população
+ * de cromossomos e com a população compacta (PackedGeneticAlgorithm), e o
+ * equivalente a uma geração do AG assíncrono (AsyncGeneticAlgorithm).
+ */
+
+#include <string>
+#include <benchmark/benchmark.h>
+#include <paradiseo/eo/eoGenContinue.h>
+#include <core/ga/genetic_algorithm.h>
+#include <core/ga/packed_genetic_algorithm.h>
+#include <core/ga/async_genetic_algorithm.h>
+#include <core/ga/evaluation_counter.h>
+#include <core/ga/crossover_fabric.h>
+#include <core/ga/tournament_selection.h>
+#include <mknapsack/mknap_problem.h>
+
+/**
+ * Argumentos: [0] ID do crossover, [1] tamanho da população */
+static void BM_OneGeneration(benchmark::State& state) {
+  const std::string instance = std::string(INSTANCES_DIR) + "/mkp/mknapcb51.txt";
+  MKnapsackProblem problem(instance.c_str());
+  EvaluationCounter evaluator(problem);
+  const eoPop<Chrom> initial = [&]() {
+    eoPop<Chrom> pop = problem.init_pop(state.range(1), 0.25);
+    evaluator.evaluate_all(pop);
+    return pop;
+  }();
+
+  TournamentSelection select(8);
+  eoQuadOp<Chrom> *cross = CrossoverFabric::create(state.range(0));
+  eoBitMutation<Chrom> mutation(0.05);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    eoPop<Chrom> pop = initial;
+    eoGenContinue<Chrom> oneGeneration(1);
+    GeneticAlgorithm ga(evaluator, select, *cross, 0.8, mutation, 1.0F,
+        oneGeneration);
+    state.ResumeTiming();
+
+    ga(pop);
+    benchmark::DoNotOptimize(pop.best_element().fitness());
+  }
+  state.SetLabel(CrossoverFabric::name(state.range(0)));
+  delete cross;
+}
+
+BENCHMARK(BM_OneGeneration)
+  ->ArgNames({"crossover", "popsize"})
+  ->ArgsProduct({{0, 1, 2}, {100, 1000}})
+  ->Unit(benchmark::kMillisecond);
+
+/**
+ * Argumentos: [0] ID do crossover, [1] tamanho da população */
+static void BM_OneGenerationPacked(benchmark::State& state) {
+  const std::string instance = std::string(INSTANCES_DIR) + "/mkp/mknapcb51.txt";
+  MKnapsackProblem problem(instance.c_str());
+  EvaluationCounter evaluator(problem);
+  PackedPopulation initial(problem.get_chromsize());
+  {
+    eoPop<Chrom> pop = problem.init_pop(state.range(1), 0.25);
+    evaluator.evaluate_all(pop);
+    initial.append(pop);
+  }
+
+  eoQuadOp<Chrom> *cross = CrossoverFabric::create(state.range(0));
+  const RateSchedule xrate = RateSchedule::parse("0.8", problem.get_chromsize());
+  const RateSchedule mrate = RateSchedule::parse("0.05", problem.get_chromsize());
+  PackedPopulation pop(problem.get_chromsize());
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    pop.resize(initial.size());
+    for (size_t i = 0; i < initial.size(); i++) pop.copy_row(i, initial, i);
+    StopCriteria oneGeneration(StopLimits::parse("gens=1"), evaluator, false);
+    PackedGeneticAlgorithm ga(evaluator, 8, *cross, xrate, mrate, oneGeneration);
+    state.ResumeTiming();
+
+    ga(pop);
+    benchmark::DoNotOptimize(pop.fitness(pop.best()));
+  }
+  state.SetLabel(CrossoverFabric::name(state.range(0)));
+  delete cross;
+}
+
+BENCHMARK(BM_OneGenerationPacked)
+  ->ArgNames({"crossover", "popsize"})
+  ->ArgsProduct({{0, 1, 2}, {100, 1000}})
+  ->Unit(benchmark::kMillisecond);
+
+/**
+ * Argumentos: [0] número de workers, [1] profundidade da fila. Uma "geração"
+ * são popsize (1000) inserções; o tempo é o real, já que a avaliação é feita
+ * por outras threads */
+static void BM_OneGenerationAsync(benchmark::State& state) {
+  const std::string instance = std::string(INSTANCES_DIR) + "/mkp/mknapcb51.txt";
+  MKnapsackProblem problem(instance.c_str());
+  EvaluationCounter evaluator(problem);
+  const eoPop<Chrom> initial = [&]() {
+    eoPop<Chrom> pop = problem.init_pop(1000, 0.25);
+    evaluator.evaluate_all(pop);
+    return pop;
+  }();
+
+  eoQuadOp<Chrom> *cross = CrossoverFabric::create(0);
+  const RateSchedule xrate = RateSchedule::parse("0.8", problem.get_chromsize());
+  const RateSchedule mrate = RateSchedule::parse("0.05", problem.get_chromsize());
+  AsyncSettings settings;
+  settings.workers = state.range(0);
+  settings.depth = state.range(1);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    eoPop<Chrom> pop = initial;
+    StopCriteria oneGeneration(StopLimits::parse("gens=1"), evaluator, false);
+    AsyncGeneticAlgorithm ga(evaluator, 8, *cross, xrate, mrate, oneGeneration,
+        settings);
+    state.ResumeTiming();
+
+    ga(pop);
+    benchmark::DoNotOptimize(pop.best_element().fitness());
+  }
+  delete cross;
+}
+
+BENCHMARK(BM_OneGenerationAsync)
+  ->ArgNames({"workers", "depth"})
+  ->ArgsProduct({{1, 2, 4}, {4, 16}})
+  ->UseRealTime()
+  ->Unit(benchmark::kMillisecond);
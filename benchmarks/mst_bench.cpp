@@ -0,0 +1,106 @@
+/**
+ * Árvore geradora mínima dos subgrafos avaliados pelo SteinerTreeProblem:
+ * o Kruskal antigo (boost::adjacency_list montado a cada chamada) contra o
+ * steiner::MinimumSpanningTree (arestas ordenadas uma vez, UnionFind
+ * reaproveitado e máscara de vértices ativos), nas instâncias de
+ * data/instances/stp.
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/kruskal_min_spanning_tree.hpp>
+#include <steinertree/steiner_tree.h>
+
+static std::string instance_path(const char *relative) {
+  return std::string(INSTANCES_DIR) + "/" + relative;
+}
+
+/**
+ * Máscaras de vértices ativos como as da avaliação: os terminais e cerca de
+ * `ratio` dos demais vértices */
+static std::vector<std::vector<bool>> active_masks(const steiner::Instance &inst,
+    double ratio, size_t count) {
+  std::vector<std::vector<bool>> masks(count, inst.terminal);
+  for (std::vector<bool> &mask : masks) {
+    for (size_t v = 0; v < mask.size(); v++) {
+      if (!mask[v] and rng.flip(ratio)) mask[v] = true;
+    }
+  }
+  return masks;
+}
+
+// Versão anterior: filtra as arestas e monta o grafo do boost a cada chamada
+static float boost_kruskal(const steiner::Instance &inst, const std::vector<bool> &active,
+    std::vector<edge_t> &edges, std::vector<float> &weights) {
+  using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS,
+      boost::no_property, boost::property<boost::edge_weight_t, float>>;
+  using Edge = boost::graph_traits<Graph>::edge_descriptor;
+
+  edges.clear();
+  weights.clear();
+  for (size_t e = 0; e < inst.edges.size(); e++) {
+    if (active[inst.edges[e].first] and active[inst.edges[e].second]) {
+      edges.push_back(inst.edges[e]);
+      weights.push_back(inst.weights[e]);
+    }
+  }
+  Graph g(edges.begin(), edges.end(), weights.begin(), inst.num_nodes);
+  auto weightof = boost::get(boost::edge_weight, g);
+  std::vector<Edge> spanning_tree;
+  boost::kruskal_minimum_spanning_tree(g, std::back_inserter(spanning_tree));
+  float total = 0;
+  for (const Edge &edge : spanning_tree) total += weightof[edge];
+  return total;
+}
+
+/**
+ * Argumento: porcentagem de vértices não terminais ativos */
+static void BM_BoostKruskal(benchmark::State& state, const char *instance) {
+  SteinerTreeProblem problem(instance_path(instance).c_str());
+  const steiner::Instance &inst = problem.get_instance();
+  auto masks = active_masks(inst, state.range(0) / 100.0, 64);
+  std::vector<edge_t> edges;
+  std::vector<float> weights;
+  size_t i = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(boost_kruskal(inst, masks[i++ % masks.size()],
+        edges, weights));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_MinimumSpanningTree(benchmark::State& state, const char *instance) {
+  SteinerTreeProblem problem(instance_path(instance).c_str());
+  const steiner::Instance &inst = problem.get_instance();
+  auto masks = active_masks(inst, state.range(0) / 100.0, 64);
+  std::vector<size_t> counts;
+  for (const std::vector<bool> &mask : masks) {
+    counts.push_back(std::count(mask.begin(), mask.end(), true));
+  }
+  steiner::MinimumSpanningTree mst(inst.num_nodes, inst.edges, inst.weights);
+  steiner::MinimumSpanningTree::Scratch scratch;
+  size_t i = 0;
+
+  for (auto _ : state) {
+    const size_t k = i++ % masks.size();
+    benchmark::DoNotOptimize(mst(scratch, &masks[k], counts[k]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+#define MST_BENCHMARKS(name, file)                                            \
+  BENCHMARK_CAPTURE(BM_BoostKruskal, name, file)                              \
+    ->ArgName("active%")->Arg(25)->Arg(100)->Unit(benchmark::kMicrosecond);   \
+  BENCHMARK_CAPTURE(BM_MinimumSpanningTree, name, file)                       \
+    ->ArgName("active%")->Arg(25)->Arg(100)->Unit(benchmark::kMicrosecond)
+
+MST_BENCHMARKS(steinb10, "stp/steinb10.txt");
+MST_BENCHMARKS(steind10, "stp/steind10.txt");
+MST_BENCHMARKS(steind15, "stp/steind15.txt");
+MST_BENCHMARKS(steine4, "stp/steine4.txt");
+MST_BENCHMARKS(steine9, "stp/steine9.txt");
+MST_BENCHMARKS(steine10, "stp/steine10.txt");
@@ -0,0 +1,140 @@
+/**
+ * Benchmarks das funções objetivo (Problem::operator() e, onde existe,
+ * Problem::evaluate_batch) de cada problema usando instâncias representativas
+ * de data/instances.
+ */
+
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <benchmark/benchmark.h>
+#include <core/ga/linear_objective.h>
+#include <core/ga/packed_population.h>
+#include <maxclique/maximum_weighted_clique_problem.h>
+#include <mknapsack/mknap_problem.h>
+#include <setcovering/set_covering_problem.h>
+#include <steinertree/steiner_tree.h>
+
+static std::string instance_path(const char *relative) {
+  return std::string(INSTANCES_DIR) + "/" + relative;
+}
+
+/**
+ * Avalia, em rodízio, os cromossomos de uma população aleatória fixa. Como no
+ * AG, eles são reparados antes (fora da medição). A avaliação guarda no
+ * cromossomo o estado da avaliação incremental (MKP), então ele é descartado
+ * antes de cada chamada para medir sempre a avaliação completa. */
+template <class ConcreteProblem>
+static void BM_Evaluate(benchmark::State& state, const char *instance) {
+  ConcreteProblem problem(instance_path(instance).c_str());
+  eoPop<Chrom> pop = problem.init_pop(64, 0.25);
+  for (Chrom &chrom : pop) problem.repair(chrom);
+  size_t i = 0;
+
+  for (auto _ : state) {
+    Chrom &chrom = pop[i++ % pop.size()];
+    chrom.evalState.reset();
+    problem(chrom);
+    benchmark::DoNotOptimize(chrom.fitness());
+  }
+  state.counters["chromsize"] = problem.get_chromsize();
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_SetCovering(benchmark::State& state, const char *instance) {
+  BM_Evaluate<SetCoveringProblem>(state, instance);
+}
+
+static void BM_MultiKnapsack(benchmark::State& state, const char *instance) {
+  BM_Evaluate<MKnapsackProblem>(state, instance);
+}
+
+static void BM_MaxWeightedClique(benchmark::State& state, const char *instance) {
+  BM_Evaluate<MWCProblem>(state, instance);
+}
+
+static void BM_SteinerTree(benchmark::State& state, const char *instance) {
+  BM_Evaluate<SteinerTreeProblem>(state, instance);
+}
+
+/**
+ * Avaliação em lote (Problem::evaluate_batch) de uma população compacta de
+ * 1024 indivíduos reparados com um kernel de LinearObjective fixo, para comparar com
+ * BM_Evaluate e entre os kernels */
+template <class ConcreteProblem>
+static void BM_EvaluateBatch(benchmark::State& state, const char *instance,
+    const char *kernel) {
+  try {
+    LinearObjective::set_kernel(kernel);
+  } catch (const std::invalid_argument &e) {
+    state.SkipWithError(e.what());
+    return;
+  }
+  ConcreteProblem problem(instance_path(instance).c_str());
+  eoPop<Chrom> chroms = problem.init_pop(1024, 0.25);
+  for (Chrom &chrom : chroms) problem.repair(chrom);
+  PackedPopulation pop(problem.get_chromsize());
+  pop.append(chroms);
+  std::vector<size_t> rows(pop.size());
+  std::iota(rows.begin(), rows.end(), 0);
+  std::vector<Chrom::Fitness> fitness;
+
+  for (auto _ : state) {
+    problem.evaluate_batch(pop, rows, fitness);
+    benchmark::DoNotOptimize(fitness.data());
+  }
+  LinearObjective::set_kernel("auto");
+  state.counters["chromsize"] = problem.get_chromsize();
+  state.SetItemsProcessed(state.iterations() * rows.size());
+}
+
+static void BM_SetCoveringBatch(benchmark::State& state, const char *instance,
+    const char *kernel) {
+  BM_EvaluateBatch<SetCoveringProblem>(state, instance, kernel);
+}
+
+static void BM_MultiKnapsackBatch(benchmark::State& state, const char *instance,
+    const char *kernel) {
+  BM_EvaluateBatch<MKnapsackProblem>(state, instance, kernel);
+}
+
+/**
+ * Leitura de um grafo do MWCP (mmap + linhas de adjacência compactadas) */
+static void BM_LoadGraph(benchmark::State& state, const char *instance) {
+  const std::string path = instance_path(instance);
+  size_t bytes = 0, edges = 0;
+  for (auto _ : state) {
+    packed_graph graph = packed_graph::load(path);
+    bytes = graph.file_bytes;
+    edges = graph.num_edges;
+    benchmark::DoNotOptimize(graph.adjacency.data());
+  }
+  state.counters["edges"] = edges;
+  state.SetBytesProcessed(state.iterations() * bytes);
+  state.SetItemsProcessed(state.iterations() * edges);
+}
+
+BENCHMARK_CAPTURE(BM_SetCovering, scp41, "scp/scp41.txt");
+BENCHMARK_CAPTURE(BM_SetCovering, scp52, "scp/scp52.txt");
+BENCHMARK_CAPTURE(BM_MultiKnapsack, mknapcb51, "mkp/mknapcb51.txt");
+BENCHMARK_CAPTURE(BM_MultiKnapsack, mknapcb91, "mkp/mknapcb91.txt");
+BENCHMARK_CAPTURE(BM_SetCoveringBatch, scp52_scalar, "scp/scp52.txt", "scalar");
+BENCHMARK_CAPTURE(BM_SetCoveringBatch, scp52_avx2, "scp/scp52.txt", "avx2");
+BENCHMARK_CAPTURE(BM_SetCoveringBatch, scp52_avx512, "scp/scp52.txt", "avx512");
+BENCHMARK_CAPTURE(BM_MultiKnapsackBatch, mknapcb91_scalar, "mkp/mknapcb91.txt", "scalar");
+BENCHMARK_CAPTURE(BM_MultiKnapsackBatch, mknapcb91_avx2, "mkp/mknapcb91.txt", "avx2");
+BENCHMARK_CAPTURE(BM_MultiKnapsackBatch, mknapcb91_avx512, "mkp/mknapcb91.txt", "avx512");
+BENCHMARK_CAPTURE(BM_MaxWeightedClique, san1000, "mwcp/san1000.clq")
+  ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_MaxWeightedClique, p_hat1500_1, "mwcp/p_hat1500-1.clq")
+  ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_LoadGraph, san1000, "mwcp/san1000.clq")
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_LoadGraph, p_hat1500_1, "mwcp/p_hat1500-1.clq")
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_SteinerTree, steinb10, "stp/steinb10.txt")
+  ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SteinerTree, steind10, "stp/steind10.txt")
+  ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SteinerTree, steine10, "stp/steine10.txt")
+  ->Unit(benchmark::kMicrosecond);
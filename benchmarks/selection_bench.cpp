@@ -0,0 +1,77 @@
+/**
+ * Benchmarks da seleção por torneio determinístico: eoDetTournamentSelect
+ * envolvido por eoSelectPerc, como era usada no GeneticAlgorithm, e a
+ * TournamentSelection por índices com cada kernel.
+ */
+
+#include <stdexcept>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <paradiseo/eo/eoDetTournamentSelect.h>
+#include <paradiseo/eo/eoSelectPerc.h>
+#include <core/ga/random.h>
+#include <core/ga/tournament_selection.h>
+
+/**
+ * Argumentos: [0] tamanho do ring do torneio, [1] tamanho da população */
+static void BM_DetTournamentSelect(benchmark::State& state) {
+  const uint ringSize = state.range(0);
+  const uint popsize = state.range(1);
+  eoPop<Chrom> pop = Random<Chrom>::population(1000, popsize);
+  for (Chrom& chrom : pop) {
+    chrom.fitness(Random<Chrom>::uniform(0.0, 1.0));
+  }
+
+  eoDetTournamentSelect<Chrom> tournament(ringSize);
+  eoSelectPerc<Chrom> select(tournament);
+  eoPop<Chrom> selected;
+
+  for (auto _ : state) {
+    select(pop, selected);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * popsize);
+}
+
+BENCHMARK(BM_DetTournamentSelect)
+  ->ArgNames({"ring", "popsize"})
+  ->ArgsProduct({{2, 4, 8, 16}, {100, 1000}});
+
+/**
+ * Argumentos: [0] tamanho do ring do torneio, [1] tamanho da população. Os
+ * índices dos vencedores de toda a população, incluindo a cópia do fitness
+ * para o vetor contíguo */
+static void BM_TournamentSelection(benchmark::State& state, const char *kernel) {
+  try {
+    TournamentSelection::set_kernel(kernel);
+  } catch (const std::invalid_argument &e) {
+    state.SkipWithError(e.what());
+    return;
+  }
+  const uint ringSize = state.range(0);
+  const uint popsize = state.range(1);
+  eoPop<Chrom> pop = Random<Chrom>::population(1000, popsize);
+  for (Chrom& chrom : pop) {
+    chrom.fitness(Random<Chrom>::uniform(0.0, 1.0));
+  }
+
+  TournamentSelection select(ringSize);
+  std::vector<size_t> winners;
+
+  for (auto _ : state) {
+    select.select(pop, popsize, winners);
+    benchmark::DoNotOptimize(winners.data());
+  }
+  TournamentSelection::set_kernel("auto");
+  state.SetItemsProcessed(state.iterations() * popsize);
+}
+
+BENCHMARK_CAPTURE(BM_TournamentSelection, scalar, "scalar")
+  ->ArgNames({"ring", "popsize"})
+  ->ArgsProduct({{2, 8, 16}, {1000, 10000}});
+BENCHMARK_CAPTURE(BM_TournamentSelection, avx2, "avx2")
+  ->ArgNames({"ring", "popsize"})
+  ->ArgsProduct({{2, 8, 16}, {1000, 10000}});
+BENCHMARK_CAPTURE(BM_TournamentSelection, avx512, "avx512")
+  ->ArgNames({"ring", "popsize"})
+  ->ArgsProduct({{2, 8, 16}, {1000, 10000}});
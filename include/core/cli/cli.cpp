@@ -1,5 +1,7 @@
 #include "options.h"
 #include "parse.h"
+#include <memory>
+#include <stdexcept>
 
 option long_options[] = {
   { "infile",    required_argument, 0, 'f' },
@@ -10,24 +12,68 @@ option long_options[] = {
   { "xrate",     required_argument, 0, 'c' },
   { "mrate",     required_argument, 0, 'm' },
   { "ring",      required_argument, 0, 'r' },
+  { "cache",     required_argument, 0, 'k' },
+  { "checkpoint", required_argument, 0, 'w' },
+  { "ckpt-every", required_argument, 0, 'g' },
+  { "resume",    required_argument, 0, 'R' },
+  { "self-adaptive", no_argument, 0, 'a' },
+  { "restart",   required_argument, 0, 't' },
+  { "local-search", required_argument, 0, 'l' },
+  { "preprocess", required_argument, 0, 'P' },
+  { "decoder",   required_argument, 0, 'D' },
+  { "packed",    no_argument, 0, 'K' },
+  { "async",     required_argument, 0, 'A' },
   { "verbose",   no_argument, 0, 'v' },
   { "help",      no_argument, 0, 'h' },
   { 0, 0, 0, 0 }
 };
 
-const char *short_options = "f:d:p:s:x:c:m:r:vh";
+const char *short_options = "f:d:p:s:x:c:m:r:k:w:g:R:at:l:P:D:KA:vh";
 
-const unsigned int NUM_OPTIONS = 10;
+const unsigned int NUM_OPTIONS = 21;
 
 const char *DESC[NUM_OPTIONS] = {
     "Arquivo de instância do problema",
     "Arquivo .db para salvar os dados. Se não definido não salva",
     "Tamanho da população [default = 100]",
-    "Critério de parada [default = 100]",
-    "Operador de crossover utilizado com um ID [default = 0]",
-    "Taxa de cruzamento (%) [default = 0.8]",
-    "Taxa de mutação (%) [default = 0.05]",
+    "Critério de parada: número de avaliações ou limites combinados "
+    "evals=N,gens=G,time=S,target=C|opt,gap=T (para no primeiro atingido) "
+    "[default = 50]",
+    "Operador de crossover no formato nome:chave=valor,... (uniform:bias=0.5, "
+    "npoint:k=2, hux, shuffle, segmented:rate=0.2, rs-npoint:k=1 e os "
+    "operadores do problema), adaptive:ops=op1+op2+... para escolha "
+    "adaptativa entre operadores, ou um ID numérico antigo [default = uniform]",
+    "Taxa de cruzamento (%) ou cronograma (linear:from=,to=,gens= | "
+    "exp:from=,decay=,min= | diversity:low=,high=,threshold=) [default = 0.8]",
+    "Taxa de mutação por bit, também k/L (L = tamanho do cromossomo) ou "
+    "cronograma como em -c [default = 0.05]",
     "Tamanho do Ring do operador de seleção por torneio determinístico [default = 8]",
+    "Memória (MB) do cache de fitness, 0 desativa [default = 0]",
+    "Arquivo de checkpoint gravado periodicamente durante a evolução",
+    "Intervalo (em gerações) entre checkpoints [default = 50]",
+    "Retoma a execução a partir de um arquivo de checkpoint",
+    "Taxas auto-adaptativas: cada indivíduo carrega e evolui as suas",
+    "Reinício parcial da população na estagnação: gens=G (gerações sem "
+    "melhora), entropy=E (entropia média mínima), keep=K (melhores mantidos), "
+    "bias=B (viés da nova população) [default = desativado]",
+    "Busca local (etapa memética) nos melhores filhos de cada geração, se o "
+    "problema tiver uma: best=K (filhos por geração), moves=M e time=T (ms) "
+    "por geração [default = desativada]",
+    "Pré-processamento da instância, se o problema tiver um (MWCP: "
+    "order=degeneracy|weight|none,prune=0|1; STP: leaves=0|1,paths=0|1,"
+    "sd=0|1) [default = desativado]",
+    "Decodificador do cromossomo, se o problema tiver mais de um (STP: mst | "
+    "dnh; MWCP: weight | weight-degree, a regra da expansão do clique) "
+    "[default = o do problema]",
+    "População compacta para populações grandes: genes em uma matriz de bits "
+    "contígua e fitness em um vetor à parte. Sem reinícios, busca local, "
+    "checkpoints, taxas auto-adaptativas nem crossover adaptativo",
+    "AG steady-state assíncrono: os filhos são avaliados por threads e "
+    "inseridos à medida que ficam prontos. workers=N (threads), depth=D "
+    "(filhos em avaliação ao mesmo tempo) ou auto (uma thread por núcleo, "
+    "depth = 2 por thread). Só para problemas que avaliam em paralelo (MKP, "
+    "STP); sem reinícios, busca local, checkpoints, taxas auto-adaptativas "
+    "nem crossover adaptativo",
     "Ativa os log no console",
     "Mostra essa lista de opções"
 };
@@ -47,8 +93,42 @@ void show_help(char **argv) {
   }
 }
 
-CLI *parse(int argc, char **argv) {
-  CLI* res = new CLI();
+/**
+ * Uma taxa numérica vai para `rate`; qualquer outra coisa (k/L ou um
+ * cronograma) é guardada em `schedule` e interpretada pelo RateSchedule */
+static void parse_rate(const char *arg, double &rate, std::string &schedule) {
+  try {
+    size_t pos = 0;
+    const double value = std::stod(arg, &pos);
+    if (arg[pos] == '\0') {
+      rate = value;
+      schedule.clear();
+      return;
+    }
+  } catch (std::exception &e) {
+  }
+  schedule = arg;
+}
+
+/**
+ * Um número inteiro é o limite de avaliações; qualquer outra coisa é um
+ * critério composto, interpretado por StopLimits */
+static void parse_stop(const char *arg, unsigned int &stop, std::string &spec) {
+  try {
+    size_t pos = 0;
+    const unsigned long value = std::stoul(arg, &pos);
+    if (arg[pos] == '\0') {
+      stop = value;
+      spec.clear();
+      return;
+    }
+  } catch (std::exception &e) {
+  }
+  spec = arg;
+}
+
+CLI *parse(int argc, char **argv, bool exitOnError) {
+  std::unique_ptr<CLI> res(new CLI());
   int opt;
   while ((opt = getopt_long(argc,argv, short_options,long_options,0)) != -1) {
     switch (opt) {
@@ -65,32 +145,67 @@ CLI *parse(int argc, char **argv) {
         if (optarg) res->pop_size = std::stoi(optarg);
         break;
       case 's':
-        if (optarg) res->stop_criteria = std::stoi(optarg);
+        if (optarg) parse_stop(optarg, res->stop_criteria, res->stop_spec);
         break;
       case 'c':
-        if (optarg) res->crossover_rate = std::stod(optarg);
+        if (optarg) parse_rate(optarg, res->crossover_rate, res->crossover_schedule);
         break;
       case 'm':
-        if (optarg) res->mutation_rate = std::stod(optarg);
+        if (optarg) parse_rate(optarg, res->mutation_rate, res->mutation_schedule);
         break;
       case 'x':
-        if (optarg) res->crossover_id = std::stoi(optarg);
+        if (optarg) res->crossover = optarg;
         break;
       case 'r':
         if (optarg) res->tour_size = std::stoi(optarg);
         break;
+      case 'k':
+        if (optarg) res->cache_mb = std::stoi(optarg);
+        break;
+      case 'w':
+        if (optarg) res->checkpoint_file = optarg;
+        break;
+      case 'g':
+        if (optarg) res->checkpoint_every = std::stoi(optarg);
+        break;
+      case 'R':
+        if (optarg) res->resume_file = optarg;
+        break;
+      case 'a':
+        res->self_adaptive = true;
+        break;
+      case 't':
+        if (optarg) res->restart = optarg;
+        break;
+      case 'l':
+        if (optarg) res->local_search = optarg;
+        break;
+      case 'P':
+        if (optarg) res->preprocess = optarg;
+        break;
+      case 'D':
+        if (optarg) res->decoder = optarg;
+        break;
+      case 'K':
+        res->packed = true;
+        break;
+      case 'A':
+        if (optarg) res->async_spec = optarg;
+        break;
       case 'v':
         res->verbose = true;
         break;
       case 'h':
+        if (!exitOnError) throw std::invalid_argument("-h não é aceito no --sweep");
         show_help(argv);
         exit(127);
       default:
+        if (!exitOnError) throw std::invalid_argument("opção inválida");
         printf("Use -h ou --help para ver as opções de linha de comandos.\n");
         exit(2);
     }
   }
 
-  return res;
+  return res.release();
 }
 
@@ -10,10 +10,24 @@ struct CLI {
     char *infile;
     unsigned int pop_size;
     unsigned int stop_criteria;
-    unsigned int crossover_id;
+    std::string stop_spec;           // critério composto de -s quando não é um número
+    std::string crossover;
     double crossover_rate;
     double mutation_rate;
+    std::string crossover_schedule;  // cronograma de -c quando não é um número
+    std::string mutation_schedule;   // cronograma de -m quando não é um número
+    bool self_adaptive;
+    bool packed;                     // população compacta (PackedPopulation)
+    std::string async_spec;          // AG assíncrono (vazio = geracional)
+    std::string restart;             // política de reinício (vazio = sem)
+    std::string local_search;        // orçamento da busca local (vazio = sem)
+    std::string preprocess;          // pré-processamento da instância (vazio = sem)
+    std::string decoder;             // decodificador do problema (vazio = padrão)
     unsigned int tour_size;
+    unsigned int cache_mb;
+    char *checkpoint_file;
+    unsigned int checkpoint_every;
+    char *resume_file;
     char *databasefile;
     bool using_db;
     bool verbose;
@@ -23,10 +37,16 @@ struct CLI {
         this->infile = (char *) "";
         this->pop_size = 100;
         this->stop_criteria = 50;
-        this->crossover_id = 0;
+        this->crossover = "uniform";
         this->crossover_rate = 0.8;
         this->mutation_rate = 0.05;
+        this->self_adaptive = false;
+        this->packed = false;
         this->tour_size = 8;
+        this->cache_mb = 0;
+        this->checkpoint_file = (char *) "";
+        this->checkpoint_every = 50;
+        this->resume_file = (char *) "";
         this->databasefile = (char *) "";
         this->using_db = false;
         this->verbose = false;
@@ -37,18 +57,46 @@ struct CLI {
         this->infile = f;
         this->pop_size = p;
         this->stop_criteria = g;
-        this->crossover_id = c;
+        this->crossover = std::to_string(c);
         this->crossover_rate = cr;
         this->mutation_rate = mr;
+        this->self_adaptive = false;
+        this->packed = false;
+        this->cache_mb = 0;
+        this->checkpoint_file = (char *) "";
+        this->checkpoint_every = 50;
+        this->resume_file = (char *) "";
     }
 
     friend std::ostream& operator << (std::ostream& os, CLI& cli) {
-        std::string cross_name = cli.crossover_id == 0? "Uniforme" : std::to_string(cli.crossover_id).append("-Pontos");
         os << "População  : " << cli.pop_size << "\n";
-        os << "N. Gerações: " << cli.stop_criteria << "\n";
-        os << "Crossover  : " << cross_name << "\n";
-        os << "Tx de cruz.: " << cli.crossover_rate*100 << "%\n";
-        os << "Tx de muta.: " << cli.mutation_rate*100 << "%\n";
+        if (cli.stop_spec.empty())
+            os << "Avaliações : " << cli.stop_criteria << "\n";
+        else
+            os << "Parada     : " << cli.stop_spec << "\n";
+        os << "Crossover  : " << cli.crossover << "\n";
+        if (cli.crossover_schedule.empty())
+            os << "Tx de cruz.: " << cli.crossover_rate*100 << "%\n";
+        else
+            os << "Tx de cruz.: " << cli.crossover_schedule << "\n";
+        if (cli.mutation_schedule.empty())
+            os << "Tx de muta.: " << cli.mutation_rate*100 << "%\n";
+        else
+            os << "Tx de muta.: " << cli.mutation_schedule << "\n";
+        if (cli.self_adaptive)
+            os << "Taxas auto-adaptativas\n";
+        if (cli.packed)
+            os << "População compacta\n";
+        if (!cli.async_spec.empty())
+            os << "Assíncrono : " << cli.async_spec << "\n";
+        if (!cli.restart.empty())
+            os << "Reinício   : " << cli.restart << "\n";
+        if (!cli.local_search.empty())
+            os << "Busca local: " << cli.local_search << "\n";
+        if (!cli.preprocess.empty())
+            os << "Pré-proces.: " << cli.preprocess << "\n";
+        if (!cli.decoder.empty())
+            os << "Decodific. : " << cli.decoder << "\n";
         os << "Tam.Torneio: " << cli.tour_size << "\n";
         return os;
     }
@@ -10,9 +10,11 @@
 void show_help(char **argv);
 
 /**
- * Anaçisar os argumentos passados por linha de comando
+ * Anaçisar os argumentos passados por linha de comando. Com exitOnError
+ * falso (modo --sweep), -h e opções inválidas lançam std::invalid_argument
+ * em vez de encerrar o processo
  */
-CLI *parse(int argc, char **argv);
+CLI *parse(int argc, char **argv, bool exitOnError = true);
 
 /**
  * Define uma string ID para cada cominação de parâmetros
@@ -1,13 +1,19 @@
 #ifndef CORE_DB_BASE_MODEL_HPP_
 #define CORE_DB_BASE_MODEL_HPP_
 
+#include <set>
 #include <string>
 #include <sstream>
+#include <utility>
 #include <vector>
 #include <sqlite/connection.hpp>
 #include <sqlite/execute.hpp>
+#include <sqlite/query.hpp>
 #include <sqlite/database_exception.hpp>
 #include "../ga/encoding.h"
+#include "../ga/phase_timer.h"
+#include "../ga/evaluation_counter.h"
+#include "../ga/crossover_fabric.h"
 
 namespace db {
 
@@ -21,20 +27,36 @@ public:
 
   // OBS: unsigned int não funciona diretamente com o operator% de sqlite::execute
   int population_size;        // Tamanho da população de indivíduos
-  int stop_criteria;          // Número de gerações
+  int stop_criteria;          // Limite de avaliações (-s numérico)
   int crossover_id;           // ID do operador de crossover
   double crossover_rate;      // Taxa de cruzamento
   double mutation_rate;       // Taxa de mutação
   double duration_in_ms;      // Duração da evolução em milisegundos
+  int objective_calls;        // Chamadas reais à função objetivo
+  int repair_calls;           // Chamadas ao operador de reparo
+  int cache_hits;             // Avaliações resolvidas pelo cache de fitness
+  int local_search_moves;     // Movimentos examinados pela busca local
+  int restarts;               // Reinícios parciais da população (RestartPolicy)
+  int evals_to_target;        // Avaliações até atingir o custo alvo (-1 = não)
+  double time_to_target_ms;   // Tempo até atingir o custo alvo (-1 = não)
   std::string crossover_name; // Nome do operador de crossover
   std::string convergence;    // Convergência da busca (texto com separador)
   std::string instance_file;  // Nome do arquivo de instancia usado
+  std::string phase_times;    // Tempo (ms) gasto em cada fase do AG
+  std::string operator_log;   // Uso e recompensa por geração do crossover adaptativo
+  std::string rates;          // Taxas de cruzamento/mutação por geração (RateControl)
+  std::string stop_rule;      // Limites de parada usados (StopLimits)
+  std::string stop_reason;    // Critério de parada que encerrou a execução
 
   BaseModel(const char *t_tablename)
   : table_name(t_tablename), population_size(0), stop_criteria(0),
     crossover_id(0), crossover_rate(0.0), mutation_rate(0.0),
-    duration_in_ms(0.0), crossover_name(std::string()),
-    convergence(std::string()) {}
+    duration_in_ms(0.0), objective_calls(0), repair_calls(0), cache_hits(0),
+    local_search_moves(0), restarts(0), evals_to_target(-1), time_to_target_ms(-1.0),
+    crossover_name(std::string()),
+    convergence(std::string()), phase_times(std::string()),
+    operator_log(std::string()), rates(std::string()),
+    stop_rule(std::string()), stop_reason(std::string()) {}
 
   // Default destructor
   ~BaseModel() = default;
@@ -68,6 +90,26 @@ public:
     this->convergence = BaseModel::sequence_to_string<double>(convVec);
   }
 
+  // Define o atributo phase_times a partir dos acumuladores do AG
+  void set_phase_times(const PhaseTimer& timer) {
+    this->phase_times = timer.to_string();
+  }
+
+  // Define o operador de crossover a partir da sua descrição textual. O ID
+  // numérico antigo é mantido quando existe (-1 caso contrário)
+  void set_crossover(const std::string& spec) {
+    this->crossover_id = CrossoverFabric::id(spec);
+    this->crossover_name = CrossoverSpec::parse(spec).to_string();
+  }
+
+  // Define os contadores de avaliação a partir do avaliador do AG
+  void set_evaluation_counts(const EvaluationCounter& counter) {
+    this->objective_calls = int(counter.objective_calls());
+    this->repair_calls = int(counter.repair_calls());
+    this->cache_hits = int(counter.cache_hits());
+    this->local_search_moves = int(counter.local_search_moves());
+  }
+
   // TODO: adicionar metodo de setar a duração
 
   // TODO: problema com o instance_file
@@ -76,6 +118,36 @@ public:
   // Cria esturtura da tabela no banco de dados
   virtual void create(sqlite::connection *con) = 0;
 
+  /**
+   * Acrescenta (ALTER TABLE ... ADD COLUMN) as colunas comuns que faltam em
+   * uma tabela criada por uma versão anterior, já que o CREATE TABLE IF NOT
+   * EXISTS não altera tabelas existentes. As linhas antigas ficam com NULL
+   * nessas colunas. Chamado pelo create() de cada modelo */
+  void migrate(sqlite::connection *con) {
+    // Colunas comuns que não existiam na primeira versão das tabelas
+    static const std::vector<std::pair<const char *, const char *>> added = {
+      {"phase_times", "TEXT"}, {"objective_calls", "INTEGER"},
+      {"repair_calls", "INTEGER"}, {"cache_hits", "INTEGER"},
+      {"local_search_moves", "INTEGER"}, {"operator_log", "TEXT"},
+      {"rates", "TEXT"}, {"restarts", "INTEGER"}, {"stop_rule", "TEXT"},
+      {"stop_reason", "TEXT"}, {"time_to_target_ms", "REAL"},
+      {"evals_to_target", "INTEGER"}
+    };
+
+    // Coluna 1 do PRAGMA table_info: nome da coluna
+    std::set<std::string> existing;
+    sqlite::query info(*con, "PRAGMA table_info(" + std::string(this->table_name) + ");");
+    auto rows = info.get_result();
+    while (rows->next_row()) {
+      existing.insert(rows->get_string(1));
+    }
+    for (const auto &column : added) {
+      if (existing.count(column.first)) continue;
+      sqlite::execute(*con, "ALTER TABLE " + std::string(this->table_name) +
+          " ADD COLUMN " + column.first + " " + column.second + ";", true);
+    }
+  }
+
   // Inserir os dados de (*this) no banco de dados
   virtual void insert(sqlite::connection *con) = 0;
 };
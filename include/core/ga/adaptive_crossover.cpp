@@ -0,0 +1,93 @@
+#include "adaptive_crossover.h"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <paradiseo/eo/utils/eoRNG.h>
+
+AdaptiveCrossover::AdaptiveCrossover(
+    std::vector<std::pair<std::string, eoQuadOp<Chrom> *>> operators,
+    double alpha, double beta, double pmin)
+  : alpha(alpha), beta(beta), pmin(pmin) {
+  for (auto &op : operators) {
+    this->names.push_back(op.first);
+    this->ops.push_back(op.second);
+  }
+  const size_t k = this->ops.size();
+  if (k == 0) {
+    throw std::invalid_argument("AdaptiveCrossover: empty portfolio");
+  }
+  if (this->pmin <= 0.0 || this->pmin * k >= 1.0) {
+    this->pmin = std::min(0.1, 0.5 / k);
+  }
+  this->quality.assign(k, 0.0);
+  this->prob.assign(k, 1.0 / k);
+  this->totalUses.assign(k, 0);
+  this->uses.assign(k, 0);
+  this->rewardSum.assign(k, 0.0);
+}
+
+AdaptiveCrossover::~AdaptiveCrossover() {
+  for (eoQuadOp<Chrom> *op : this->ops) {
+    delete op;
+  }
+}
+
+bool AdaptiveCrossover::operator()(Chrom &chrom1, Chrom &chrom2) {
+  // Roleta sobre as probabilidades correntes
+  double r = rng.uniform();
+  size_t arm = 0;
+  while (arm + 1 < this->prob.size() && r >= this->prob[arm]) {
+    r -= this->prob[arm];
+    arm++;
+  }
+  this->lastArm = arm;
+  this->uses[arm]++;
+  this->totalUses[arm]++;
+  return (*this->ops[arm])(chrom1, chrom2);
+}
+
+void AdaptiveCrossover::reward(size_t arm, double value) {
+  this->rewardSum[arm] += value;
+}
+
+void AdaptiveCrossover::end_generation() {
+  const size_t k = this->ops.size();
+  GenerationLog log;
+  log.uses = this->uses;
+  log.meanReward.assign(k, 0.0);
+
+  for (size_t a = 0; a < k; a++) {
+    if (this->uses[a] > 0) {
+      log.meanReward[a] = this->rewardSum[a] / this->uses[a];
+      this->quality[a] += this->alpha * (log.meanReward[a] - this->quality[a]);
+    }
+  }
+
+  const size_t best = std::max_element(this->quality.begin(),
+      this->quality.end()) - this->quality.begin();
+  const double pmax = 1.0 - (k - 1) * this->pmin;
+  for (size_t a = 0; a < k; a++) {
+    const double target = a == best ? pmax : this->pmin;
+    this->prob[a] += this->beta * (target - this->prob[a]);
+  }
+  log.prob = this->prob;
+  this->history.push_back(std::move(log));
+
+  std::fill(this->uses.begin(), this->uses.end(), 0);
+  std::fill(this->rewardSum.begin(), this->rewardSum.end(), 0.0);
+}
+
+std::string AdaptiveCrossover::log_to_string() const {
+  std::stringstream ss;
+  for (size_t a = 0; a < this->names.size(); a++) {
+    ss << (a ? "|" : "") << this->names[a];
+  }
+  for (const GenerationLog &log : this->history) {
+    ss << ';';
+    for (size_t a = 0; a < log.uses.size(); a++) {
+      ss << (a ? "|" : "") << log.uses[a] << '/' << log.meanReward[a] << '/'
+         << log.prob[a];
+    }
+  }
+  return ss.str();
+}
@@ -0,0 +1,91 @@
+#ifndef CROSSOVERRESEARCH_ADAPTIVE_CROSSOVER_H
+#define CROSSOVERRESEARCH_ADAPTIVE_CROSSOVER_H
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <paradiseo/eo/eoOp.h>
+#include "encoding.h"
+
+/**
+ * @class AdaptiveCrossover
+ * Portfólio de operadores de crossover em que cada aplicação usa um operador
+ * sorteado de acordo com o crédito que ele obteve até então.
+ *
+ * A política é o Adaptive Pursuit (Thierens, 2005): cada operador tem uma
+ * qualidade estimada Q e uma probabilidade de uso p. Ao fim de cada geração
+ * o Q dos operadores usados se aproxima (taxa alpha) da recompensa média que
+ * eles receberam na geração, e as probabilidades perseguem (taxa beta) o
+ * operador de maior Q, sem que nenhuma fique abaixo de pmin. Como só importa
+ * qual operador tem o maior Q, a escala das recompensas não afeta a escolha.
+ *
+ * As recompensas são informadas pelo GeneticAlgorithm depois da avaliação
+ * dos filhos (ver reward), usando o operador devolvido por last_arm.
+ */
+class AdaptiveCrossover : public eoQuadOp<Chrom> {
+public:
+  /**
+   * @param operators nomes e operadores do portfólio (a posse dos ponteiros
+   * passa para esta classe)
+   * @param alpha taxa de atualização das qualidades
+   * @param beta taxa de perseguição das probabilidades
+   * @param pmin probabilidade mínima de cada operador (< 1/K)
+   */
+  AdaptiveCrossover(
+      std::vector<std::pair<std::string, eoQuadOp<Chrom> *>> operators,
+      double alpha = 0.3, double beta = 0.3, double pmin = 0.0);
+
+  ~AdaptiveCrossover();
+
+  AdaptiveCrossover(const AdaptiveCrossover &) = delete;
+  AdaptiveCrossover &operator=(const AdaptiveCrossover &) = delete;
+
+  /**
+   * Sorteia um operador e o aplica aos dois cromossomos */
+  bool operator()(Chrom &chrom1, Chrom &chrom2) override;
+
+  std::string className() const { return "AdaptiveCrossover"; }
+
+  // Operador usado na última aplicação
+  size_t last_arm() const { return this->lastArm; }
+
+  /**
+   * Crédito de uma aplicação do operador `arm` na geração corrente */
+  void reward(size_t arm, double value);
+
+  /**
+   * Atualiza qualidades e probabilidades com as recompensas da geração e a
+   * registra no histórico */
+  void end_generation();
+
+  size_t size() const { return this->ops.size(); }
+  const std::string &name(size_t arm) const { return this->names[arm]; }
+  double probability(size_t arm) const { return this->prob[arm]; }
+  unsigned long total_uses(size_t arm) const { return this->totalUses[arm]; }
+
+  /**
+   * Histórico por geração: "nome1|nome2|...;g1;g2;..." onde cada gi tem, para
+   * cada operador, "usos/recompensa média/probabilidade" separados por '|' */
+  std::string log_to_string() const;
+
+private:
+  std::vector<eoQuadOp<Chrom> *> ops;
+  std::vector<std::string> names;
+  double alpha, beta, pmin;
+  std::vector<double> quality, prob;
+  std::vector<unsigned long> totalUses;
+  size_t lastArm = 0;
+
+  // Geração corrente
+  std::vector<unsigned> uses;
+  std::vector<double> rewardSum;
+
+  struct GenerationLog {
+    std::vector<unsigned> uses;
+    std::vector<double> meanReward;
+    std::vector<double> prob;
+  };
+  std::vector<GenerationLog> history;
+};
+
+#endif //CROSSOVERRESEARCH_ADAPTIVE_CROSSOVER_H
@@ -0,0 +1,245 @@
+#include "async_genetic_algorithm.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <paradiseo/eo/utils/eoRNG.h>
+#include "adaptive_crossover.h"
+#include "crossover_fabric.h"
+
+AsyncSettings AsyncSettings::parse(const std::string &text) {
+  if (text.empty() or text == "auto") return AsyncSettings();
+  // Same parameter format as the crossover operators
+  const CrossoverSpec spec = CrossoverSpec::parse("async:" + text);
+  spec.check_params({"workers", "depth"});
+  const double workers = spec.get("workers", 0), depth = spec.get("depth", 0);
+  if (workers < 0 or depth < 0) {
+    throw std::invalid_argument("async: workers e depth devem ser >= 0");
+  }
+  AsyncSettings settings;
+  settings.workers = unsigned(workers);
+  settings.depth = unsigned(depth);
+  return settings;
+}
+
+std::string AsyncSettings::to_string() const {
+  std::stringstream ss;
+  ss << "workers=" << this->workers << ",depth=" << this->depth;
+  return ss.str();
+}
+
+AsyncGeneticAlgorithm::AsyncGeneticAlgorithm(
+    EvaluationCounter &evaluator_,
+    uint32_t tourRingSize_,
+    eoQuadOp<Chrom> &crossoverOp_,
+    const RateSchedule &crossoverRate_,
+    const RateSchedule &mutationRate_,
+    StopCriteria &continue_,
+    const AsyncSettings &settings_)
+  : evaluator(evaluator_),
+    selection(tourRingSize_),
+    cross(crossoverOp_),
+    crossoverRate(crossoverRate_),
+    mutationRate(mutationRate_),
+    stopCriteria(continue_),
+    workers(settings_.workers ? settings_.workers :
+        std::max(1u, std::thread::hardware_concurrency())),
+    depth(std::max(2u, settings_.depth ? settings_.depth : 2 * workers))
+{
+	if (dynamic_cast<AdaptiveCrossover*>(&crossoverOp_)) {
+		throw std::invalid_argument("O crossover adaptativo não pode ser usado com o AG assíncrono");
+	}
+	if (crossoverRate_.needs_entropy() or mutationRate_.needs_entropy()) {
+		throw std::invalid_argument("Cronogramas por diversidade não podem ser usados com o AG assíncrono");
+	}
+}
+
+std::vector<AsyncGeneticAlgorithm::Fitness> &AsyncGeneticAlgorithm::get_convergence() {
+  return this->convergence;
+}
+
+uint32_t AsyncGeneticAlgorithm::get_generation() const {
+  return this->generation;
+}
+
+const PhaseTimer &AsyncGeneticAlgorithm::get_phase_timer() const {
+  return this->phaseTimer;
+}
+
+void AsyncGeneticAlgorithm::work(Problem &problem, BoundedQueue<Chrom> &jobs,
+		BoundedQueue<Result> &results, double &busySeconds)
+{
+	using clock = std::chrono::steady_clock;
+	FitnessCache *cache = this->evaluator.get_cache();
+	std::vector<packed::word_t> key;
+	Result result;
+	while (!this->stopping.load(std::memory_order_acquire)) {
+		if (!jobs.try_pop(result.chrom)) {
+			std::this_thread::yield();
+			continue;
+		}
+		const clock::time_point start = clock::now();
+		problem.repair(result.chrom);
+		// The cache is partitioned with a lock per partition, so the workers
+		// share the one of the counter
+		result.cacheHit = false;
+		if (cache) {
+			Fitness fitness;
+			packed::pack(result.chrom, key);
+			if (cache->lookup(key, fitness)) {
+				result.chrom.fitness(fitness);
+				result.cacheHit = true;
+			}
+		}
+		if (!result.cacheHit) {
+			problem(result.chrom);
+			if (cache) cache->insert(key, result.chrom.fitness());
+		}
+		busySeconds += std::chrono::duration<double>(clock::now() - start).count();
+
+		// There are never more results than offspring in flight, which fit in
+		// the queue, so this only spins while the master is still taking the
+		// result that last used the slot
+		while (!results.try_push(result)) std::this_thread::yield();
+	}
+}
+
+bool AsyncGeneticAlgorithm::insert(eoPop<Chrom> &population, Chrom &child)
+{
+	auto worst = std::min_element(population.begin(), population.end());
+	if (*worst < child) {
+		if (this->best < child.fitness()) this->best = child.fitness();
+		*worst = child;
+	}
+	if (++this->inserted % population.size() != 0) return true;
+
+	// Save to convergence at every population-size insertions
+	this->convergence.push_back(this->best);
+	this->generation++;
+	this->mutation.set_rate(this->mutationRate.value(this->generation, 0.0));
+	return this->stopCriteria(this->best);
+}
+
+void AsyncGeneticAlgorithm::operator()(eoPop<Chrom> &population)
+{
+	using clock = std::chrono::steady_clock;
+	std::cout << "Stopper: " << this->stopCriteria.className()
+	          << " (assíncrono, " << this->workers << " workers, profundidade "
+	          << this->depth << ")" << std::endl;
+
+	this->convergence.clear();
+	this->generation = 0;
+	this->inserted = 0;
+	this->phaseTimer.reset();
+	this->utilisation = 0.0;
+	if (population.empty()) return;
+
+	// One copy of the problem per worker: the counter keeps the original
+	std::vector<std::unique_ptr<Problem>> problems;
+	for (unsigned w = 0; w < this->workers; w++) {
+		problems.emplace_back(this->evaluator.get_problem().clone_evaluator());
+		if (!problems.back()) {
+			throw std::invalid_argument("O problema não pode ser avaliado em paralelo (AG assíncrono)");
+		}
+	}
+
+	BoundedQueue<Chrom> jobs(this->depth);
+	BoundedQueue<Result> results(this->depth);
+	std::vector<double> busy(this->workers, 0.0);
+	std::vector<std::thread> threads;
+	this->stopping.store(false);
+	const clock::time_point start = clock::now();
+	for (unsigned w = 0; w < this->workers; w++) {
+		threads.emplace_back(&AsyncGeneticAlgorithm::work, this,
+				std::ref(*problems[w]), std::ref(jobs), std::ref(results),
+				std::ref(busy[w]));
+	}
+
+	this->best = population.best_element().fitness();
+	this->mutation.set_rate(this->mutationRate.value(0, 0.0));
+	size_t inFlight = 0;
+	const unsigned long budget = this->evaluator.get_budget();
+	Chrom offspring[2];
+	Result done;
+	bool running = true;
+	while (running) {
+		bool idle = true;
+		this->phaseTimer.start();
+
+		// Breeds pairs while there is room in the queue and the budget covers
+		// the offspring already in flight
+		while (running and inFlight + 2 <= this->depth and (budget == 0 or
+				this->evaluator.objective_calls() + inFlight < budget)) {
+			idle = false;
+			offspring[0] = this->selection(population);
+			offspring[1] = this->selection(population);
+			this->phaseTimer.lap(PhaseTimer::selection);
+
+			bool changed[2] = {false, false};
+			if (rng.flip(this->crossoverRate.value(this->generation, 0.0)) and
+					this->cross(offspring[0], offspring[1])) {
+				changed[0] = changed[1] = true;
+			}
+			this->phaseTimer.lap(PhaseTimer::crossover);
+			for (int c = 0; c < 2; c++) {
+				if (this->mutation(offspring[c])) changed[c] = true;
+			}
+			this->phaseTimer.lap(PhaseTimer::mutation);
+
+			// Unchanged copies of the parents need no evaluation, and offspring
+			// the budget does not cover are discarded
+			for (int c = 0; c < 2 and running; c++) {
+				if (changed[c]) {
+					if (budget and this->evaluator.objective_calls() + inFlight >= budget) continue;
+					// A push only fails while a worker is still taking the job
+					// that last used the slot
+					offspring[c].invalidate();
+					while (!jobs.try_push(offspring[c])) std::this_thread::yield();
+					inFlight++;
+				} else {
+					running = this->insert(population, offspring[c]);
+				}
+			}
+			this->phaseTimer.lap(PhaseTimer::elitism);
+		}
+
+		// Inserts the offspring evaluated so far
+		while (inFlight > 0 and results.try_pop(done)) {
+			idle = false;
+			inFlight--;
+			this->evaluator.count_evaluation(done.chrom.fitness(), done.cacheHit);
+			if (running) running = this->insert(population, done.chrom);
+		}
+		this->phaseTimer.lap(PhaseTimer::evaluation);
+
+		// Budget spent and nothing left to wait for (the stop criteria still
+		// records why the GA stopped)
+		if (running and inFlight == 0 and this->evaluator.exhausted()) {
+			this->stopCriteria(this->best);
+			running = false;
+		}
+		if (idle) std::this_thread::yield();
+	}
+
+	// Offspring no worker has taken are dropped; the others were evaluated
+	// and count, but arrive too late to be inserted
+	while (inFlight > 0 and jobs.try_pop(offspring[0])) inFlight--;
+	while (inFlight > 0) {
+		if (results.try_pop(done)) {
+			inFlight--;
+			this->evaluator.count_evaluation(done.chrom.fitness(), done.cacheHit);
+		} else {
+			std::this_thread::yield();
+		}
+	}
+	this->stopping.store(true, std::memory_order_release);
+	for (std::thread &t : threads) t.join();
+
+	const double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+	double busySeconds = 0.0;
+	for (double b : busy) busySeconds += b;
+	if (elapsed > 0) this->utilisation = busySeconds / (elapsed * this->workers);
+}
@@ -0,0 +1,127 @@
+#ifndef CROSSOVERRESEARCH_ASYNC_GENETIC_ALGORITHM_H
+#define CROSSOVERRESEARCH_ASYNC_GENETIC_ALGORITHM_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <paradiseo/eo/eoOp.h>
+#include <paradiseo/eo/eoPop.h>
+#include "encoding.h"
+#include "evaluation_counter.h"
+#include "stop_criteria.h"
+#include "rate_control.h"
+#include "phase_timer.h"
+#include "tournament_selection.h"
+#include <core/utils/bounded_queue.h>
+
+/**
+ * @struct AsyncSettings
+ * Worker threads and queue depth of the asynchronous GA, in the format of
+ * the crossover parameters: "workers=4,depth=16" ("auto" or 0 for the
+ * defaults). By default there is one worker per hardware thread and two
+ * offspring in flight per worker.
+ */
+struct AsyncSettings {
+  unsigned workers = 0;
+  unsigned depth = 0;
+
+  static AsyncSettings parse(const std::string &text);
+
+  std::string to_string() const;
+};
+
+/**
+ * @class AsyncGeneticAlgorithm
+ * A steady-state GA with master-worker evaluation. The master selects
+ * parents by tournament, applies crossover and bit-flip mutation, and
+ * pushes the changed offspring into a bounded lock-free queue; worker
+ * threads repair and evaluate them with their own copy of the problem
+ * (Problem::clone_evaluator) and push them back. Each evaluated child
+ * replaces the worst individual of the population when it is better, as
+ * soon as it arrives, so the master never waits for a whole generation and
+ * a slow evaluation only delays its own child.
+ *
+ * The depth bounds the offspring in flight: a deeper queue keeps workers
+ * busy when evaluation times vary, at the cost of children bred from an
+ * older population. Every population-size insertions count as one
+ * generation for the convergence, the rate schedules and the stop criteria;
+ * offspring still in flight when the GA stops are counted as evaluations
+ * but discarded. With an evaluation budget no more offspring are submitted
+ * than the budget covers.
+ *
+ * The order in which results arrive depends on thread timing, so runs are
+ * not reproducible from the seed. Restarts, local search, checkpoints,
+ * self-adaptive rates and the adaptive crossover are not available here.
+ */
+class AsyncGeneticAlgorithm {
+public:
+  typedef typename Chrom::Fitness Fitness;
+
+  AsyncGeneticAlgorithm(
+      EvaluationCounter &evaluator_,
+      uint32_t tourRingSize_,
+      eoQuadOp<Chrom> &crossoverOp_,
+      const RateSchedule &crossoverRate_,
+      const RateSchedule &mutationRate_,
+      StopCriteria &continue_,
+      const AsyncSettings &settings_);
+
+  ~AsyncGeneticAlgorithm() = default;
+
+  // Getter for the convergence vector (best fitness of each generation)
+  std::vector<Fitness> &get_convergence();
+
+  uint32_t get_generation() const;
+
+  // Getter for the time the master spent in each phase of the last execution
+  const PhaseTimer &get_phase_timer() const;
+
+  unsigned get_workers() const { return this->workers; }
+  unsigned get_depth() const { return this->depth; }
+
+  // Fraction of the last execution the workers spent repairing and
+  // evaluating (1 = always busy)
+  double get_utilisation() const { return this->utilisation; }
+
+  // Evolves the population until the stop criteria fires. Every individual
+  // of the population must have been evaluated (see
+  // EvaluationCounter::evaluate_all)
+  void operator()(eoPop<Chrom> &population);
+
+protected:
+  // An evaluated child on its way back to the master
+  struct Result {
+    Chrom chrom;
+    bool cacheHit = false;
+  };
+
+  EvaluationCounter &evaluator;
+  TournamentSelection selection;
+  eoQuadOp<Chrom> &cross;
+  BitFlipMutation mutation;
+  RateSchedule crossoverRate;
+  RateSchedule mutationRate;
+  StopCriteria &stopCriteria;
+  unsigned workers;
+  unsigned depth;
+  std::vector<Fitness> convergence;
+  PhaseTimer phaseTimer;
+  uint32_t generation = 0;
+  double utilisation = 0.0;
+
+  std::atomic<bool> stopping{false};
+  size_t inserted = 0;  // offspring inserted in the population
+  Fitness best;
+
+  // Worker loop: evaluates the offspring of `jobs` with `problem` until
+  // `stopping` is set, adding the time spent to `busySeconds`
+  void work(Problem &problem, BoundedQueue<Chrom> &jobs,
+      BoundedQueue<Result> &results, double &busySeconds);
+
+  // Replaces the worst individual with `child` if it is better; returns
+  // false when the stop criteria fires at the end of a generation
+  bool insert(eoPop<Chrom> &population, Chrom &child);
+};
+
+#endif //CROSSOVERRESEARCH_ASYNC_GENETIC_ALGORITHM_H
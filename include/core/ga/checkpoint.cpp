@@ -0,0 +1,177 @@
+#include "checkpoint.h"
+#include "packed_bits.h"
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+#include <paradiseo/eo/utils/eoRNG.h>
+
+namespace {
+
+const char MAGIC[4] = { 'X', 'S', 'C', 'K' };
+const uint32_t VERSION = 2;  // 2: taxas auto-adaptativas por indivíduo
+
+template <typename T>
+void write_value(FILE *f, const T &value) {
+  if (fwrite(&value, sizeof(T), 1, f) != 1) {
+    throw std::runtime_error("Checkpoint: falha de escrita");
+  }
+}
+
+template <typename T>
+T read_value(FILE *f) {
+  T value;
+  if (fread(&value, sizeof(T), 1, f) != 1) {
+    throw std::runtime_error("Checkpoint: arquivo truncado");
+  }
+  return value;
+}
+
+void write_bytes(FILE *f, const void *data, size_t len) {
+  if (len > 0 and fwrite(data, 1, len, f) != len) {
+    throw std::runtime_error("Checkpoint: falha de escrita");
+  }
+}
+
+void read_bytes(FILE *f, void *data, size_t len) {
+  if (len > 0 and fread(data, 1, len, f) != len) {
+    throw std::runtime_error("Checkpoint: arquivo truncado");
+  }
+}
+
+} // namespace
+
+std::string Checkpoint::capture_rng() {
+  std::stringstream ss;
+  rng.printOn(ss);
+  return ss.str();
+}
+
+void Checkpoint::restore_rng(const std::string &state) {
+  std::stringstream ss(state);
+  rng.readFrom(ss);
+}
+
+void Checkpoint::save(const std::string &filename) const {
+  const std::string tmpname = filename + ".tmp";
+  FILE *f = fopen(tmpname.c_str(), "wb");
+  if (f == nullptr) {
+    throw std::runtime_error("Checkpoint: não foi possível criar " + tmpname);
+  }
+
+  try {
+    write_bytes(f, MAGIC, sizeof(MAGIC));
+    write_value<uint32_t>(f, VERSION);
+    write_value<uint32_t>(f, this->generation);
+    write_value<double>(f, this->elapsed_seconds);
+    write_value<uint64_t>(f, this->objective_calls);
+    write_value<uint64_t>(f, this->repair_calls);
+    write_value<uint64_t>(f, this->cache_hits);
+    write_value<uint64_t>(f, this->skipped);
+
+    // População: tamanho, tamanho do cromossomo e então, para cada
+    // indivíduo, o fitness (com flag de validade), as taxas próprias e os
+    // genes compactados
+    const uint32_t popsize = this->population.size();
+    const uint32_t chromsize = popsize > 0 ? this->population[0].size() : 0;
+    write_value<uint32_t>(f, popsize);
+    write_value<uint32_t>(f, chromsize);
+    std::vector<packed::word_t> words;
+    for (const Chrom &chrom : this->population) {
+      const uint8_t valid = chrom.invalid() ? 0 : 1;
+      write_value<uint8_t>(f, valid);
+      write_value<Chrom::Fitness>(f, valid ? chrom.fitness() : Chrom::Fitness());
+      write_value<double>(f, chrom.crossoverRate);
+      write_value<double>(f, chrom.mutationRate);
+      packed::pack(chrom, words);
+      write_bytes(f, words.data(), words.size() * sizeof(packed::word_t));
+    }
+
+    write_value<uint32_t>(f, this->convergence.size());
+    write_bytes(f, this->convergence.data(),
+        this->convergence.size() * sizeof(Chrom::Fitness));
+
+    write_value<uint32_t>(f, this->rng_state.size());
+    write_bytes(f, this->rng_state.data(), this->rng_state.size());
+  }
+  catch (std::exception &e) {
+    fclose(f);
+    remove(tmpname.c_str());
+    throw;
+  }
+
+  // Garante que os dados estão no disco antes de substituir o anterior
+  if (fflush(f) != 0 or fsync(fileno(f)) != 0) {
+    fclose(f);
+    remove(tmpname.c_str());
+    throw std::runtime_error("Checkpoint: falha ao gravar " + tmpname);
+  }
+  fclose(f);
+
+  if (rename(tmpname.c_str(), filename.c_str()) != 0) {
+    remove(tmpname.c_str());
+    throw std::runtime_error("Checkpoint: falha ao renomear para " + filename);
+  }
+}
+
+Checkpoint Checkpoint::load(const std::string &filename) {
+  FILE *f = fopen(filename.c_str(), "rb");
+  if (f == nullptr) {
+    throw std::runtime_error("Checkpoint: não foi possível abrir " + filename);
+  }
+
+  Checkpoint ckpt;
+  try {
+    char magic[sizeof(MAGIC)];
+    read_bytes(f, magic, sizeof(magic));
+    if (memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+      throw std::runtime_error("Checkpoint: " + filename + " não é um checkpoint");
+    }
+    const uint32_t version = read_value<uint32_t>(f);
+    if (version < 1 or version > VERSION) {
+      throw std::runtime_error("Checkpoint: versão incompatível em " + filename);
+    }
+    ckpt.generation = read_value<uint32_t>(f);
+    ckpt.elapsed_seconds = read_value<double>(f);
+    ckpt.objective_calls = read_value<uint64_t>(f);
+    ckpt.repair_calls = read_value<uint64_t>(f);
+    ckpt.cache_hits = read_value<uint64_t>(f);
+    ckpt.skipped = read_value<uint64_t>(f);
+
+    const uint32_t popsize = read_value<uint32_t>(f);
+    const uint32_t chromsize = read_value<uint32_t>(f);
+    std::vector<packed::word_t> words(packed::num_words(chromsize));
+    ckpt.population.resize(popsize);
+    for (Chrom &chrom : ckpt.population) {
+      const uint8_t valid = read_value<uint8_t>(f);
+      const Chrom::Fitness fitness = read_value<Chrom::Fitness>(f);
+      if (version >= 2) {
+        chrom.crossoverRate = read_value<double>(f);
+        chrom.mutationRate = read_value<double>(f);
+      }
+      read_bytes(f, words.data(), words.size() * sizeof(packed::word_t));
+      chrom.resize(chromsize);
+      packed::unpack(words.data(), chrom);
+      if (valid) {
+        chrom.fitness(fitness);
+      } else {
+        chrom.invalidate();
+      }
+    }
+
+    ckpt.convergence.resize(read_value<uint32_t>(f));
+    read_bytes(f, ckpt.convergence.data(),
+        ckpt.convergence.size() * sizeof(Chrom::Fitness));
+
+    ckpt.rng_state.resize(read_value<uint32_t>(f));
+    read_bytes(f, &ckpt.rng_state[0], ckpt.rng_state.size());
+  }
+  catch (std::exception &e) {
+    fclose(f);
+    throw;
+  }
+
+  fclose(f);
+  return ckpt;
+}
@@ -0,0 +1,46 @@
+#ifndef CROSSOVERRESEARCH_CHECKPOINT_H
+#define CROSSOVERRESEARCH_CHECKPOINT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "encoding.h"
+
+/**
+ * @class Checkpoint
+ * Estado completo de uma execução do AG ao fim de uma geração: população
+ * (genes, fitness e taxas auto-adaptativas), contadores de avaliação, convergência até o momento e o
+ * estado do gerador de números aleatórios global do ParadisEO. Com esses
+ * dados a execução pode ser retomada exatamente do mesmo ponto.
+ *
+ * O arquivo é binário e escrito de forma atômica: os dados vão para um
+ * arquivo temporário que só substitui o checkpoint anterior depois de
+ * completamente gravado em disco.
+ */
+class Checkpoint {
+public:
+  uint32_t generation = 0;          // Gerações já concluídas
+  double elapsed_seconds = 0.0;     // Tempo de evolução já decorrido
+  uint64_t objective_calls = 0;     // Contadores do EvaluationCounter
+  uint64_t repair_calls = 0;
+  uint64_t cache_hits = 0;
+  uint64_t skipped = 0;
+  std::vector<Chrom::Fitness> convergence; // Melhor fitness de cada geração
+  std::string rng_state;            // Estado serializado do eoRng global
+  eoPop<Chrom> population;
+
+  /**
+   * Grava o checkpoint em `filename` de forma atômica */
+  void save(const std::string &filename) const;
+
+  /**
+   * Lê um checkpoint gravado por save() */
+  static Checkpoint load(const std::string &filename);
+
+  /**
+   * Captura e restaura o estado do gerador global `rng` */
+  static std::string capture_rng();
+  static void restore_rng(const std::string &state);
+};
+
+#endif //CROSSOVERRESEARCH_CHECKPOINT_H
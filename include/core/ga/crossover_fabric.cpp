@@ -3,6 +3,151 @@
 //
 
 #include "crossover_fabric.h"
+#include "adaptive_crossover.h"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+CrossoverSpec CrossoverSpec::parse(const std::string &text) {
+	if (!text.empty() && std::all_of(text.begin(), text.end(), ::isdigit)) {
+		return parse(CrossoverFabric::spec(std::stoul(text)));
+	}
+
+	CrossoverSpec spec;
+	const size_t colon = text.find(':');
+	spec.name = text.substr(0, colon);
+	if (spec.name.empty()) {
+		throw std::invalid_argument("Crossover sem nome: '" + text + "'");
+	}
+	if (colon == std::string::npos) {
+		return spec;
+	}
+
+	size_t begin = colon + 1;
+	while (begin <= text.size()) {
+		size_t end = text.find(',', begin);
+		if (end == std::string::npos) end = text.size();
+		const std::string param = text.substr(begin, end - begin);
+		const size_t equal = param.find('=');
+		if (equal == std::string::npos || equal == 0) {
+			throw std::invalid_argument("Parâmetro de crossover inválido: '"
+					+ param + "' (use chave=valor)");
+		}
+		spec.params[param.substr(0, equal)] = param.substr(equal + 1);
+		begin = end + 1;
+	}
+	return spec;
+}
+
+double CrossoverSpec::get(const std::string &key, double defaultValue) const {
+	auto it = this->params.find(key);
+	if (it == this->params.end()) {
+		return defaultValue;
+	}
+	try {
+		return std::stod(it->second);
+	} catch (std::exception &e) {
+		throw std::invalid_argument(this->name + ": valor inválido para " + key
+				+ ": '" + it->second + "'");
+	}
+}
+
+void CrossoverSpec::check_params(const std::vector<std::string> &accepted) const {
+	for (const auto &param : this->params) {
+		if (std::find(accepted.begin(), accepted.end(), param.first) == accepted.end()) {
+			throw std::invalid_argument(this->name + " não aceita o parâmetro "
+					+ param.first);
+		}
+	}
+}
+
+std::string CrossoverSpec::to_string() const {
+	std::string str = this->name;
+	char separator = ':';
+	for (const auto &param : this->params) {
+		str += separator + param.first + "=" + param.second;
+		separator = ',';
+	}
+	return str;
+}
+
+/**
+ * Registro global, com os operadores genéricos incluídos na criação */
+std::map<std::string, CrossoverFabric::Entry> &CrossoverFabric::registry() {
+	static std::map<std::string, Entry> entries = {
+		{"uniform", {"Uniforme, cada gene trocado com probabilidade bias [bias=0.5]",
+			[](const CrossoverSpec &s) {
+				s.check_params({"bias"});
+				return create_uniform(s.get("bias", 0.5));
+			}}},
+		{"npoint", {"N pontos de corte [k=2]",
+			[](const CrossoverSpec &s) {
+				s.check_params({"k"});
+				return create_cutpoints(uint(s.get("k", 2)));
+			}}},
+		{"hux", {"Half-uniform: troca metade dos genes diferentes",
+			[](const CrossoverSpec &s) -> eoQuadOp<Chrom> * {
+				s.check_params({});
+				return new HUXCrossover();
+			}}},
+		{"shuffle", {"Shuffle crossover (um ponto sobre posições embaralhadas)",
+			[](const CrossoverSpec &s) -> eoQuadOp<Chrom> * {
+				s.check_params({});
+				return new ShuffleCrossover();
+			}}},
+		{"segmented", {"Número variável de cortes, cada posição com prob. rate [rate=0.2]",
+			[](const CrossoverSpec &s) {
+				s.check_params({"rate"});
+				return create_segmented(s.get("rate", 0.2));
+			}}},
+		{"rs-npoint", {"N pontos com substituto reduzido (cortes onde os pais diferem) [k=1]",
+			[](const CrossoverSpec &s) {
+				s.check_params({"k"});
+				return create_reduced_surrogate(uint(s.get("k", 1)));
+			}}},
+		{"adaptive", {"Escolha adaptativa entre operadores separados por '+' "
+				"[ops=uniform+npoint:k=1+npoint:k=2+hux+shuffle,alpha=0.3,beta=0.3,pmin]",
+			[](const CrossoverSpec &s) {
+				s.check_params({"ops", "alpha", "beta", "pmin"});
+				return create_adaptive(s);
+			}}},
+	};
+	return entries;
+}
+
+void CrossoverFabric::add(const std::string &name,
+		const std::string &description, Creator creator) {
+	registry()[name] = Entry{description, std::move(creator)};
+}
+
+bool CrossoverFabric::has(const std::string &name) {
+	return registry().count(name) > 0;
+}
+
+std::vector<std::pair<std::string, std::string>> CrossoverFabric::list() {
+	std::vector<std::pair<std::string, std::string>> names;
+	for (const auto &entry : registry()) {
+		names.emplace_back(entry.first, entry.second.description);
+	}
+	return names;
+}
+
+eoQuadOp<Chrom> * CrossoverFabric::create(const std::string &spec) {
+	return create(CrossoverSpec::parse(spec));
+}
+
+eoQuadOp<Chrom> * CrossoverFabric::create(const CrossoverSpec &spec) {
+	auto it = registry().find(spec.name);
+	if (it == registry().end()) {
+		std::string available;
+		for (const auto &entry : registry()) {
+			available += " " + entry.first;
+		}
+		throw std::invalid_argument("Crossover desconhecido: " + spec.name
+				+ ". Disponíveis:" + available);
+	}
+	return it->second.creator(spec);
+}
 
 /**
  * Cria um operador de crossover de pontos de corte a partir de um número
@@ -29,25 +174,126 @@ eoQuadOp<Chrom> * CrossoverFabric::create_uniform(double bias) {
 	return new eoUBitXover<Chrom>(bias);
 }
 
+/**
+ * Cria um operador de N pontos de corte com substituto reduzido (cortes
+ * somente onde os pais diferem)
+ * @param numPoints
+ * @return ponteiro para o novo operador
+ */
+eoQuadOp<Chrom> * CrossoverFabric::create_reduced_surrogate(uint numPoints) {
+	return new ReducedSurrogateCrossover(numPoints);
+}
+
+/**
+ * Cria um operador de crossover segmentado
+ * @param switchRate probabilidade de cada posição ser um ponto de corte
+ * @return ponteiro para o novo operador
+ */
+eoQuadOp<Chrom> * CrossoverFabric::create_segmented(double switchRate) {
+	return new SegmentedCrossover(switchRate);
+}
+
+/**
+ * Cria um portfólio adaptativo com os operadores listados no parâmetro ops
+ * (descrições separadas por '+')
+ * @param spec
+ * @return ponteiro para o novo operador
+ */
+eoQuadOp<Chrom> * CrossoverFabric::create_adaptive(const CrossoverSpec &spec) {
+	auto it = spec.params.find("ops");
+	const std::string ops = it != spec.params.end() ? it->second
+			: "uniform+npoint:k=1+npoint:k=2+hux+shuffle";
+
+	std::vector<std::pair<std::string, eoQuadOp<Chrom> *>> portfolio;
+	try {
+		size_t begin = 0;
+		while (begin <= ops.size()) {
+			size_t end = ops.find('+', begin);
+			if (end == std::string::npos) end = ops.size();
+			const CrossoverSpec opSpec = CrossoverSpec::parse(ops.substr(begin, end - begin));
+			if (opSpec.name == "adaptive") {
+				throw std::invalid_argument("Crossover adaptive não pode conter outro adaptive");
+			}
+			portfolio.emplace_back(opSpec.to_string(), nullptr);
+			portfolio.back().second = create(opSpec);
+			begin = end + 1;
+		}
+	} catch (...) {
+		for (auto &op : portfolio) delete op.second;
+		throw;
+	}
+	return new AdaptiveCrossover(std::move(portfolio), spec.get("alpha", 0.3),
+			spec.get("beta", 0.3), spec.get("pmin", 0.0));
+}
+
 eoQuadOp<Chrom> * CrossoverFabric::create(uint crossID) {
-	if (crossID == 0) {
-		return create_uniform();
+	return create(spec(crossID));
+}
+
+std::string CrossoverFabric::spec(uint crossID) {
+	if (crossID == UNIFORM) {
+		return "uniform";
+	} else if (crossID < HUX) {
+		return "npoint:k=" + std::to_string(crossID);
+	} else if (crossID == HUX) {
+		return "hux";
+	} else if (crossID == SHUFFLE) {
+		return "shuffle";
+	} else if (crossID == SEGMENTED) {
+		return "segmented";
+	} else if (crossID > REDUCED_SURROGATE && crossID < REDUCED_SURROGATE + HUX) {
+		return "rs-npoint:k=" + std::to_string(crossID - REDUCED_SURROGATE);
 	} else {
-		return create_cutpoints(crossID);
+		throw std::invalid_argument("CrossoverFabric: unknown crossover ID "
+				+ std::to_string(crossID));
 	}
 }
 
+/**
+ * O ID só existe para as descrições que correspondem exatamente a um dos
+ * operadores numerados, com os parâmetros padrão dos IDs
+ */
+int CrossoverFabric::id(const std::string &text) {
+	const CrossoverSpec spec = CrossoverSpec::parse(text);
+	const std::string canonical = spec.to_string();
+	if (canonical == "uniform" || canonical == "uniform:bias=0.5") return UNIFORM;
+	if (canonical == "hux") return HUX;
+	if (canonical == "shuffle") return SHUFFLE;
+	if (canonical == "segmented" || canonical == "segmented:rate=0.2") return SEGMENTED;
+
+	const bool npoint = spec.name == "npoint", rs = spec.name == "rs-npoint";
+	const bool onlyK = spec.params.empty()
+			|| (spec.params.size() == 1 && spec.params.count("k"));
+	if ((npoint || rs) && onlyK) {
+		const int k = int(spec.get("k", npoint ? 2 : 1));
+		if (k >= 1 && k < int(HUX) && spec.get("k", k) == k) {
+			return npoint ? k : int(REDUCED_SURROGATE) + k;
+		}
+	}
+	return -1;
+}
+
 /**
  * Returns the name of the crossover operator to respective crossover ID
  */
 std::string CrossoverFabric::name(uint crossID) {
-	if (crossID == 0) {
+	if (crossID == UNIFORM) {
 		return "UNIFORM";
 	} else if (crossID == 1) {
 		return "ONE-POINT";
-	} else {
+	} else if (crossID < HUX) {
 		std::string str = std::to_string(crossID);
 		str += "-POINTS";
 		return str;
+	} else if (crossID == HUX) {
+		return "HUX";
+	} else if (crossID == SHUFFLE) {
+		return "SHUFFLE";
+	} else if (crossID == SEGMENTED) {
+		return "SEGMENTED";
+	} else if (crossID > REDUCED_SURROGATE && crossID < REDUCED_SURROGATE + HUX) {
+		return "RS-" + name(crossID - REDUCED_SURROGATE);
+	} else {
+		return "UNKNOWN";
 	}
 }
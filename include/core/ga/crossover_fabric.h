@@ -6,15 +6,95 @@
 #define CROSSOVERRESEARCH_CROSSOVER_FABRIC_H
 
 #include "encoding.h"
+#include "packed_crossover.h"
 #include <paradiseo/eo/ga/eoBitOp.h>
+#include <functional>
+#include <map>
 #include <string>
+#include <vector>
 
+/**
+ * @struct CrossoverSpec
+ * Descrição textual de um operador de crossover no formato
+ * "nome:chave=valor,chave=valor", por exemplo "npoint:k=4" ou
+ * "uniform:bias=0.3". Um número sozinho é aceito como o ID numérico antigo
+ * (0 uniforme, 1-99 N pontos, 100 HUX, 101 shuffle, 102 segmentado, 200+N
+ * N pontos com substituto reduzido).
+ */
+struct CrossoverSpec {
+	std::string name;
+	std::map<std::string, std::string> params;
+
+	static CrossoverSpec parse(const std::string &text);
+
+	/**
+	 * Valor numérico de um parâmetro ou `defaultValue` se não informado */
+	double get(const std::string &key, double defaultValue) const;
+
+	/**
+	 * Lança uma exceção se houver parâmetros fora de `accepted` */
+	void check_params(const std::vector<std::string> &accepted) const;
+
+	/**
+	 * Forma canônica: nome seguido dos parâmetros em ordem alfabética */
+	std::string to_string() const;
+};
+
+/**
+ * Registro de operadores de crossover por nome. Os operadores genéricos são
+ * registrados na primeira utilização; problemas podem registrar operadores
+ * próprios em Problem::register_crossovers. O registro é global, então o
+ * criador deve capturar por valor o que o operador usa, sem referências ao
+ * problema que o registrou.
+ */
 class CrossoverFabric {
 public:
-	static std::string name(uint crossID);
+	using Creator = std::function<eoQuadOp<Chrom> *(const CrossoverSpec &)>;
+
+	static constexpr uint UNIFORM = 0;
+	static constexpr uint HUX = 100;
+	static constexpr uint SHUFFLE = 101;
+	static constexpr uint SEGMENTED = 102;
+	static constexpr uint REDUCED_SURROGATE = 200;
+
+	/**
+	 * Registra (ou substitui) o operador `name` */
+	static void add(const std::string &name, const std::string &description,
+			Creator creator);
+
+	static bool has(const std::string &name);
+
+	/**
+	 * Nomes e descrições dos operadores registrados */
+	static std::vector<std::pair<std::string, std::string>> list();
+
+	static eoQuadOp<Chrom> *create(const std::string &spec);
+	static eoQuadOp<Chrom> *create(const CrossoverSpec &spec);
 	static eoQuadOp<Chrom> *create(uint crossID);
+
+	/**
+	 * Converte um ID numérico antigo para a descrição textual */
+	static std::string spec(uint crossID);
+
+	/**
+	 * ID numérico antigo de uma descrição, ou -1 se não houver */
+	static int id(const std::string &spec);
+
+	static std::string name(uint crossID);
+
 	static eoQuadOp<Chrom> *create_uniform(double bias = 0.5);
 	static eoQuadOp<Chrom> *create_cutpoints(uint numPoints);
+	static eoQuadOp<Chrom> *create_reduced_surrogate(uint numPoints);
+	static eoQuadOp<Chrom> *create_segmented(double switchRate = 0.2);
+	static eoQuadOp<Chrom> *create_adaptive(const CrossoverSpec &spec);
+
+private:
+	struct Entry {
+		std::string description;
+		Creator creator;
+	};
+
+	static std::map<std::string, Entry> &registry();
 };
 
 #endif //CROSSOVERRESEARCH_CROSSOVER_FABRIC_H
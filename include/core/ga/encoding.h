@@ -5,6 +5,7 @@
 #ifndef CROSSOVERRESEARCH_ENCODING_H
 #define CROSSOVERRESEARCH_ENCODING_H
 
+#include <memory>
 #include <paradiseo/eo/ga/eoBit.h>
 #include <paradiseo/eo/eoPop.h>
 
@@ -15,8 +16,44 @@
 //   typedef double fitness_t;
 // #endif
 
+/**
+ * Estado auxiliar que um problema pode anexar a um cromossomo ao avaliá-lo
+ * (ex.: somas parciais usadas para avaliação incremental). O estado é
+ * imutável e compartilhado entre as cópias do cromossomo, então copiar um
+ * cromossomo copia só um ponteiro. Operadores genéticos não o atualizam:
+ * quem usa o estado deve verificar se ele ainda descreve os genes atuais.
+ */
+struct EvaluationState {
+  virtual ~EvaluationState() = default;
+};
+
 // Define o tipo de um cromossomo
-typedef eoBit<double> Chrom;
+class Chrom : public eoBit<double> {
+public:
+  using eoBit<double>::eoBit;
+
+  /**
+   * Troca genes, fitness e estado com outro cromossomo. Os genes não são
+   * copiados, somente os buffers são trocados */
+  void swap(Chrom &other) {
+    std::vector<bool>::swap(other);
+    std::swap(this->evalState, other.evalState);
+    std::swap(this->crossoverRate, other.crossoverRate);
+    std::swap(this->mutationRate, other.mutationRate);
+
+    const bool thisValid = !this->invalid(), otherValid = !other.invalid();
+    const Fitness thisFitness = thisValid ? this->fitness() : Fitness();
+    if (otherValid) this->fitness(other.fitness()); else this->invalidate();
+    if (thisValid) other.fitness(thisFitness); else other.invalidate();
+  }
+
+  std::shared_ptr<const EvaluationState> evalState;
+
+  // Taxas próprias do indivíduo no modo auto-adaptativo (ver RateControl);
+  // negativas quando não usadas
+  double crossoverRate = -1.0;
+  double mutationRate = -1.0;
+};
 
 // Define o tipo da população de cromossomos
 typedef eoPop<Chrom> Population;
@@ -2,24 +2,25 @@
 
 std::vector<double> Entropy::allele_vector(const Population& pop) {
   const size_t chromsize = pop[0].size();
-  const size_t popsize   = pop.size();
+  const double popsize   = pop.size();
   std::vector<double> gene_entropies(chromsize);
-  double p_zero, p_one;
+  std::vector<unsigned int> count_ones(chromsize, 0);
 
-  for (size_t i=0; i < chromsize; i++) {
-    unsigned int count_zeros = 0, count_ones = 0;
-
-    for (const Chrom& chrom : pop) {
-      if (chrom[i]) {
-        count_ones++;
-      } else {
-        count_zeros++;
-      }
+  for (const Chrom& chrom : pop) {
+    for (size_t i=0; i < chromsize; i++) {
+      count_ones[i] += chrom[i];
     }
+  }
 
-    p_zero = count_zeros / popsize;
-    p_one  =  count_ones / popsize;
-    gene_entropies[i] = p_zero*log2(p_zero) + p_one*log2(p_one);
+  // Entropia binária de cada gene, com 0 log 0 = 0: vai de 0 (todos os
+  // indivíduos iguais no gene) a 1 (metade com cada alelo)
+  for (size_t i=0; i < chromsize; i++) {
+    const double p_one  = count_ones[i] / popsize;
+    const double p_zero = 1.0 - p_one;
+    double h = 0.0;
+    if (p_one > 0)  h -= p_one  * log2(p_one);
+    if (p_zero > 0) h -= p_zero * log2(p_zero);
+    gene_entropies[i] = h;
   }
 
   return gene_entropies;
@@ -29,4 +30,4 @@ double Entropy::overall(const Population& population) {
   std::vector<double> genes = Entropy::allele_vector(population);
   double sum_entr = std::accumulate(genes.begin(), genes.end(), 0.0);
   return (double) (sum_entr / genes.size());
-}
\ No newline at end of file
+}
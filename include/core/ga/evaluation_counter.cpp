@@ -0,0 +1,149 @@
+#include "evaluation_counter.h"
+#include <cstring>
+#include <unordered_map>
+
+void EvaluationCounter::repair(Chrom &chromosome) {
+  if (!chromosome.invalid() or this->exhausted()) {
+    return;
+  }
+  this->problem.repair(chromosome);
+  this->repairCalls++;
+}
+
+void EvaluationCounter::evaluate(Chrom &chromosome) {
+  if (!chromosome.invalid()) {
+    this->skippedValid++;
+    return;
+  }
+  if (this->exhausted()) {
+    return;
+  }
+  this->call_objective(chromosome);
+}
+
+void EvaluationCounter::evaluate_all(eoPop<Chrom> &pop) {
+  for (Chrom &chromosome : pop) {
+    if (chromosome.invalid()) {
+      this->problem.repair(chromosome);
+      this->repairCalls++;
+      this->call_objective(chromosome);
+    } else {
+      this->skippedValid++;
+    }
+  }
+}
+
+void EvaluationCounter::evaluate_rows(PackedPopulation &pop,
+    const std::vector<size_t> &rows) {
+  if (!this->problem.has_batch_evaluation()) {
+    for (size_t i : rows) this->evaluate_row(pop, i);
+    return;
+  }
+
+  const size_t nwords = packed::num_words(pop.num_genes());
+  const bool repairs = this->problem.has_repair();
+  // Primeira linha do lote com cada hash de genes, para que cópias iguais
+  // dentro do lote contem como acertos de cache, como na avaliação uma a uma
+  std::unordered_map<uint64_t, size_t> pending;
+  this->batchRows.clear();
+  this->batchCopies.clear();
+  for (size_t i : rows) {
+    if (!pop.invalid(i)) {
+      this->skippedValid++;
+      continue;
+    }
+    if (this->budget > 0 and this->objectiveCalls + this->batchRows.size() >= this->budget) {
+      break;
+    }
+    if (repairs) {
+      pop.store(i, this->scratch);
+      this->problem.repair(this->scratch);
+      this->repairCalls++;
+      pop.load(i, this->scratch);
+    }
+    if (this->cache) {
+      const packed::word_t *row = pop.row(i);
+      this->key.assign(row, row + nwords);
+      FitnessCache::Fitness fitness;
+      if (this->cache->lookup(this->key, fitness)) {
+        pop.set_fitness(i, fitness);
+        this->cacheHits++;
+        continue;
+      }
+      auto found = pending.emplace(packed::hash(row, nwords), this->batchRows.size());
+      if (!found.second and std::memcmp(row, pop.row(this->batchRows[found.first->second]),
+          nwords * sizeof(packed::word_t)) == 0) {
+        this->batchCopies.emplace_back(i, found.first->second);
+        continue;
+      }
+    }
+    this->batchRows.push_back(i);
+  }
+
+  if (this->batchRows.empty()) return;
+  this->problem.evaluate_batch(pop, this->batchRows, this->batchFitness);
+  for (size_t r = 0; r < this->batchRows.size(); r++) {
+    const size_t i = this->batchRows[r];
+    this->objectiveCalls++;
+    this->observe(this->batchFitness[r]);
+    pop.set_fitness(i, this->batchFitness[r]);
+    if (this->cache) {
+      this->key.assign(pop.row(i), pop.row(i) + nwords);
+      this->cache->insert(this->key, this->batchFitness[r]);
+    }
+  }
+  for (const auto &copy : this->batchCopies) {
+    pop.set_fitness(copy.first, this->batchFitness[copy.second]);
+    this->cacheHits++;
+  }
+}
+
+void EvaluationCounter::evaluate_row(PackedPopulation &pop, size_t i) {
+  pop.store(i, this->scratch);
+  this->repair(this->scratch);
+  this->evaluate(this->scratch);
+  // Continua inválida se o orçamento acabou
+  if (!this->scratch.invalid()) {
+    pop.load(i, this->scratch);
+  }
+}
+
+void EvaluationCounter::call_objective(Chrom &chromosome) {
+  if (this->cache == nullptr) {
+    this->problem(chromosome);
+    this->objectiveCalls++;
+    this->observe(chromosome.fitness());
+    return;
+  }
+
+  // A chave é o cromossomo já reparado, então o fitness em cache vale para
+  // qualquer cromossomo que chegue a esses mesmos genes
+  FitnessCache::Fitness fitness;
+  packed::pack(chromosome, this->key);
+  if (this->cache->lookup(this->key, fitness)) {
+    chromosome.fitness(fitness);
+    this->cacheHits++;
+  } else {
+    this->problem(chromosome);
+    this->objectiveCalls++;
+    this->observe(chromosome.fitness());
+    this->cache->insert(this->key, chromosome.fitness());
+  }
+}
+
+void EvaluationCounter::reset() {
+  this->objectiveCalls = 0;
+  this->repairCalls = 0;
+  this->cacheHits = 0;
+  this->skippedValid = 0;
+  this->localSearchMoves = 0;
+}
+
+void EvaluationCounter::restore(unsigned long objective, unsigned long repairs,
+    unsigned long hits, unsigned long skippedValid_)
+{
+  this->objectiveCalls = objective;
+  this->repairCalls = repairs;
+  this->cacheHits = hits;
+  this->skippedValid = skippedValid_;
+}
@@ -0,0 +1,188 @@
+#ifndef CROSSOVERRESEARCH_EVALUATION_COUNTER_H
+#define CROSSOVERRESEARCH_EVALUATION_COUNTER_H
+
+#include <chrono>
+#include <functional>
+#include <utility>
+#include <string>
+#include <vector>
+#include <paradiseo/eo/eoContinue.h>
+#include "problem.h"
+#include "fitness_cache.h"
+#include "packed_population.h"
+
+/**
+ * @class EvaluationCounter
+ * Ponto único de avaliação usado por todas as variantes do AG. Toda chamada à
+ * função objetivo (e ao reparo) passa por aqui, então as contagens valem para
+ * a população inicial, para os AGs específicos de problema e para qualquer
+ * critério de parada baseado em avaliações.
+ *
+ * Contabiliza separadamente:
+ *  - chamadas reais à função objetivo (as únicas que consomem o orçamento);
+ *  - chamadas ao reparo (Problem::repair);
+ *  - acertos de cache (fitness obtido sem chamar a função objetivo, quando
+ *    um FitnessCache é configurado);
+ *  - indivíduos com fitness válido que não precisaram ser reavaliados;
+ *  - movimentos examinados pela busca local (LocalSearch), que não chamam a
+ *    função objetivo mas são o custo da etapa memética.
+ *
+ * Quando o orçamento se esgota, os indivíduos seguintes permanecem inválidos
+ * e cabe ao AG descartá-los, o que permite parar exatamente no orçamento
+ * mesmo no meio de uma geração.
+ */
+class EvaluationCounter : public eoEvalFunc<Chrom> {
+public:
+  /**
+   * @param problem_ problema cujas funções de reparo e objetivo são usadas
+   * @param budget_ número máximo de chamadas à função objetivo (0 = sem limite)
+   */
+  explicit EvaluationCounter(Problem &problem_, unsigned long budget_ = 0)
+  : problem(problem_), budget(budget_) {}
+
+  /**
+   * Repara e avalia um cromossomo inválido */
+  void operator()(Chrom &chromosome) override {
+    this->repair(chromosome);
+    this->evaluate(chromosome);
+  }
+
+  /**
+   * Aplica o reparo do problema a um cromossomo inválido. Não faz nada se
+   * o fitness do cromossomo é válido ou se o orçamento acabou. */
+  void repair(Chrom &chromosome);
+
+  /**
+   * Avalia um cromossomo inválido se ainda houver orçamento */
+  void evaluate(Chrom &chromosome);
+
+  /**
+   * Avalia (e repara) toda a população sem respeitar o orçamento. Usado
+   * na população inicial, que sempre precisa estar completamente avaliada
+   * para o AG começar. As avaliações ainda são contadas. */
+  void evaluate_all(eoPop<Chrom> &pop);
+
+  /**
+   * Repara e avalia as linhas inválidas `rows` de uma população compacta,
+   * na ordem dada e respeitando o orçamento como evaluate(). Se o problema
+   * tem avaliação em lote (Problem::evaluate_batch), as linhas que não
+   * estão no cache são avaliadas de uma vez; senão, uma a uma. As linhas
+   * que o orçamento não cobre continuam inválidas. */
+  void evaluate_rows(PackedPopulation &pop, const std::vector<size_t> &rows);
+
+  // Verifica se o orçamento de avaliações foi atingido
+  bool exhausted() const {
+    return this->budget > 0 and this->objectiveCalls >= this->budget;
+  }
+
+  /**
+   * Define um cache de fitness consultado antes da função objetivo (o
+   * cache não é copiado e deve existir enquanto o contador for usado). Use
+   * nullptr para desativar. */
+  void set_cache(FitnessCache *cache_) { this->cache = cache_; }
+  FitnessCache *get_cache() const { return this->cache; }
+
+  void set_budget(unsigned long value) { this->budget = value; }
+  unsigned long get_budget() const { return this->budget; }
+
+  unsigned long objective_calls() const { return this->objectiveCalls; }
+  unsigned long repair_calls() const { return this->repairCalls; }
+  unsigned long cache_hits() const { return this->cacheHits; }
+  unsigned long skipped() const { return this->skippedValid; }
+  unsigned long local_search_moves() const { return this->localSearchMoves; }
+
+  /**
+   * Contabiliza um reparo e uma avaliação feitos fora do contador, por outra
+   * cópia do problema (ver AsyncGeneticAlgorithm), que resultaram em
+   * `fitness`: um acerto de cache se `cacheHit`, senão uma chamada à função
+   * objetivo */
+  void count_evaluation(Problem::Fitness fitness, bool cacheHit) {
+    this->repairCalls++;
+    if (cacheHit) this->cacheHits++; else this->objectiveCalls++;
+    this->observe(fitness);
+  }
+
+  /**
+   * Passa a registrar o momento e o número de chamadas à função objetivo da
+   * primeira avaliação cujo fitness satisfaz `reached` (o alvo de
+   * StopCriteria). Um critério vazio desativa o registro. */
+  void watch_target(std::function<bool(Problem::Fitness)> reached) {
+    this->targetReached = std::move(reached);
+    this->targetHit = false;
+  }
+
+  bool target_hit() const { return this->targetHit; }
+  unsigned long target_evaluations() const { return this->targetEvaluations; }
+  std::chrono::steady_clock::time_point target_time() const { return this->targetTime; }
+
+  // Contabiliza movimentos examinados por uma busca local
+  void count_moves(unsigned long moves) { this->localSearchMoves += moves; }
+
+  /**
+   * Zera todos os contadores (o orçamento é mantido) */
+  void reset();
+
+  /**
+   * Restaura os contadores de uma execução interrompida (ver Checkpoint) */
+  void restore(unsigned long objective, unsigned long repairs,
+      unsigned long hits, unsigned long skippedValid_);
+
+  Problem &get_problem() { return this->problem; }
+
+protected:
+  Problem &problem;
+  unsigned long budget;
+  unsigned long objectiveCalls = 0;
+  unsigned long repairCalls = 0;
+  unsigned long cacheHits = 0;
+  unsigned long skippedValid = 0;
+  unsigned long localSearchMoves = 0;
+  FitnessCache *cache = nullptr;
+  std::function<bool(Problem::Fitness)> targetReached;
+  bool targetHit = false;
+  unsigned long targetEvaluations = 0;
+  std::chrono::steady_clock::time_point targetTime;
+  std::vector<packed::word_t> key; // cromossomo compactado (chave do cache)
+  Chrom scratch;                   // linha desempacotada para o problema
+  std::vector<size_t> batchRows;   // linhas enviadas a evaluate_batch
+  std::vector<std::pair<size_t, size_t>> batchCopies; // (linha, lote) repetidas
+  std::vector<Problem::Fitness> batchFitness;
+
+  // Avalia uma linha pelo cromossomo desempacotado
+  void evaluate_row(PackedPopulation &pop, size_t i);
+
+  // Chama a função objetivo passando antes pelo cache, se houver
+  void call_objective(Chrom &chromosome);
+
+  // Registra a primeira avaliação que atinge o alvo (ver watch_target)
+  void observe(Problem::Fitness fitness) {
+    if (!this->targetHit and this->targetReached and this->targetReached(fitness)) {
+      this->targetHit = true;
+      this->targetEvaluations = this->objectiveCalls;
+      this->targetTime = std::chrono::steady_clock::now();
+    }
+  }
+};
+
+
+/**
+ * @class BudgetContinue
+ * Critério de parada que encerra a evolução quando o orçamento de avaliações
+ * de um EvaluationCounter se esgota.
+ */
+class BudgetContinue : public eoContinue<Chrom> {
+public:
+  explicit BudgetContinue(const EvaluationCounter &counter_)
+  : counter(counter_) {}
+
+  bool operator()(const eoPop<Chrom> &) override {
+    return !this->counter.exhausted();
+  }
+
+  std::string className() const override { return "BudgetContinue"; }
+
+private:
+  const EvaluationCounter &counter;
+};
+
+#endif //CROSSOVERRESEARCH_EVALUATION_COUNTER_H
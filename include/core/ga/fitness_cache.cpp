@@ -0,0 +1,55 @@
+#include "fitness_cache.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+FitnessCache::FitnessCache(size_t memoryBudget, size_t chromsize)
+: numWords(packed::num_words(chromsize)), numSlots(0),
+  locks(new std::mutex[NUM_PARTITIONS])
+{
+  const size_t bytesPerSlot = sizeof(uint64_t) + sizeof(Fitness) + sizeof(char)
+                            + this->numWords * sizeof(packed::word_t);
+  this->numSlots = memoryBudget / bytesPerSlot;
+  if (this->numSlots == 0) {
+    throw std::invalid_argument("FitnessCache: memória insuficiente para uma entrada");
+  }
+  this->hashes.assign(this->numSlots, 0);
+  this->fitnesses.assign(this->numSlots, Fitness());
+  this->keys.assign(this->numSlots * this->numWords, 0);
+  this->used.assign(this->numSlots, 0);
+}
+
+bool FitnessCache::lookup(const std::vector<packed::word_t> &key, Fitness &fitness) {
+  const uint64_t h = packed::hash(key.data(), this->numWords);
+  const size_t slot = h % this->numSlots;
+  std::lock_guard<std::mutex> guard(this->locks[slot % NUM_PARTITIONS]);
+
+  if (this->used[slot] and this->hashes[slot] == h) {
+    const packed::word_t *stored = &this->keys[slot * this->numWords];
+    if (std::equal(stored, stored + this->numWords, key.data())) {
+      fitness = this->fitnesses[slot];
+      this->numHits++;
+      return true;
+    }
+    this->numCollisions++;
+  }
+  this->numMisses++;
+  return false;
+}
+
+void FitnessCache::insert(const std::vector<packed::word_t> &key, Fitness fitness) {
+  const uint64_t h = packed::hash(key.data(), this->numWords);
+  const size_t slot = h % this->numSlots;
+  std::lock_guard<std::mutex> guard(this->locks[slot % NUM_PARTITIONS]);
+
+  this->used[slot] = 1;
+  this->hashes[slot] = h;
+  this->fitnesses[slot] = fitness;
+  std::memcpy(&this->keys[slot * this->numWords], key.data(),
+      this->numWords * sizeof(packed::word_t));
+}
+
+double FitnessCache::hit_rate() const {
+  const uint64_t total = this->numHits + this->numMisses;
+  return total == 0 ? 0.0 : double(this->numHits) / double(total);
+}
@@ -0,0 +1,62 @@
+#ifndef CROSSOVERRESEARCH_FITNESS_CACHE_H
+#define CROSSOVERRESEARCH_FITNESS_CACHE_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "packed_bits.h"
+
+/**
+ * @class FitnessCache
+ * Cache limitado de fitness indexado pelo hash do cromossomo compactado.
+ *
+ * A tabela é de mapeamento direto: cada hash tem uma única posição possível e
+ * uma inserção sobrescreve o que estiver lá. Cada posição guarda também as
+ * palavras do cromossomo, que são comparadas na consulta, então colisões de
+ * hash nunca devolvem um fitness errado. A tabela é dividida em partições com
+ * um mutex cada, o que permite consultas concorrentes durante avaliações em
+ * paralelo.
+ */
+class FitnessCache {
+public:
+  using Fitness = Chrom::Fitness;
+
+  /**
+   * @param memoryBudget memória máxima (em bytes) ocupada pelas entradas
+   * @param chromsize tamanho dos cromossomos armazenados
+   */
+  FitnessCache(size_t memoryBudget, size_t chromsize);
+
+  /**
+   * Procura o fitness de um cromossomo compactado. Retorna true e escreve
+   * em `fitness` quando encontra */
+  bool lookup(const std::vector<packed::word_t> &key, Fitness &fitness);
+
+  /**
+   * Guarda o fitness de um cromossomo compactado */
+  void insert(const std::vector<packed::word_t> &key, Fitness fitness);
+
+  size_t capacity() const { return this->numSlots; }
+  uint64_t hits() const { return this->numHits; }
+  uint64_t misses() const { return this->numMisses; }
+  uint64_t collisions() const { return this->numCollisions; }
+  double hit_rate() const;
+
+private:
+  static constexpr size_t NUM_PARTITIONS = 64;
+
+  size_t numWords;  // palavras por cromossomo
+  size_t numSlots;  // número de entradas da tabela
+  std::vector<uint64_t> hashes;
+  std::vector<Fitness> fitnesses;
+  std::vector<packed::word_t> keys; // numSlots * numWords palavras
+  std::vector<char> used;
+  std::unique_ptr<std::mutex[]> locks;
+
+  std::atomic<uint64_t> numHits{0};
+  std::atomic<uint64_t> numMisses{0};
+  std::atomic<uint64_t> numCollisions{0};
+};
+
+#endif //CROSSOVERRESEARCH_FITNESS_CACHE_H
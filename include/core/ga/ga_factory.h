@@ -1,62 +1,90 @@
 #ifndef CORE_GA_GA_FACTORY_H_
 #define CORE_GA_GA_FACTORY_H_
 
+#include <cmath>
 #include <cstdint>
 #include <chrono>
+#include <stdexcept>
+#include <string>
 #include <paradiseo/eo/eoOp.h>
 #include <paradiseo/eo/eoSelectOne.h>
-#include <paradiseo/eo/eoDetTournamentSelect.h>
 #include <paradiseo/eo/eoGenContinue.h>
 #include <paradiseo/eo/eoTimeContinue.h>
-#include <paradiseo/eo/eoEvalContinue.h>
 #include <paradiseo/eo/eoEvalFunc.h>
-#include <paradiseo/eo/eoEvalFuncCounter.h>
 #include "encoding.h"
 #include "genetic_algorithm.h"
+#include "packed_genetic_algorithm.h"
+#include "async_genetic_algorithm.h"
+#include "evaluation_counter.h"
 #include "crossover_fabric.h"
+#include "stop_criteria.h"
+#include "tournament_selection.h"
 
 /**
  * @class GAFabric
  * Essa classe deve criar uma uma instância de algoritmo genético dados os
  * parâmetros estabelecidos de forma acessível de fora da classe GA.
+ * Todas as fábricas avaliam por meio de um EvaluationCounter, que deve ser
+ * usado também para avaliar a população inicial.
  */
 class GAFactory {
 public:
+  explicit GAFactory(Problem &problem_)
+    : problem(problem_), evaluationCounter(problem_) {}
 
   virtual ~GAFactory() = default;
 
   virtual GeneticAlgorithm make_ga(
       uint8_t tourRingSize,
       uint32_t stop,
-      uint8_t crossoverId, 
-      float crossRate, 
+      const std::string &crossover,
+      float crossRate,
       float mutRate) = 0;
+
+  EvaluationCounter& get_evaluation_counter() {
+    return this->evaluationCounter;
+  }
+
+  /**
+   * Informa o progresso de uma execução retomada de um checkpoint, para que
+   * os critérios de parada considerem somente o que falta. Deve ser chamado
+   * antes de make_ga. */
+  void set_progress(uint32_t generations, double seconds) {
+    this->doneGenerations = generations;
+    this->doneSeconds = seconds;
+  }
+
+protected:
+  Problem &problem;
+  EvaluationCounter evaluationCounter;
+  uint32_t doneGenerations = 0;
+  double doneSeconds = 0.0;
 };
 
 /**
  * Cria um Algoritmo Genetico com o numero de geracoes como criterio de parada*/
 class GenerationsGAFactory : public GAFactory {
 public:
-  explicit GenerationsGAFactory(Problem &problem_) : problem(problem_) {}
+  explicit GenerationsGAFactory(Problem &problem_) : GAFactory(problem_) {}
 
   ~GenerationsGAFactory() = default;
 
   GeneticAlgorithm make_ga(uint8_t tourRingSize, uint32_t stop,
-      uint8_t crossoverId, float crossRate, float mutRate)
+      const std::string &crossover, float crossRate, float mutRate)
   {
-    select = eoDetTournamentSelect<Chrom>(tourRingSize);
-    stopCriteria = new eoGenContinue<Chrom>(stop);
+    select = TournamentSelection(tourRingSize);
+    stopCriteria = new eoGenContinue<Chrom>(
+        stop > doneGenerations ? stop - doneGenerations : 1);
     mutationOp = eoBitMutation<Chrom>(mutRate);
-    crossoverPtr = CrossoverFabric::create(crossoverId);
+    crossoverPtr = CrossoverFabric::create(crossover);
 
-    GeneticAlgorithm ga(problem,
+    GeneticAlgorithm ga(evaluationCounter,
         select, *crossoverPtr, crossRate, mutationOp, 1.0F, *stopCriteria);
     return ga;
   }
 
 private:
-  Problem &problem;
-  eoDetTournamentSelect<Chrom> select;
+  TournamentSelection select;
   eoQuadOp<Chrom> *crossoverPtr;
   eoBitMutation<Chrom> mutationOp;
   eoGenContinue<Chrom> *stopCriteria;
@@ -68,28 +96,28 @@ private:
  * Cria um Algoritmo Genetico com um tempo como criterio de parada */
 class TimeGAFactory : public GAFactory {
 public:
-  explicit TimeGAFactory(Problem &problem_) : problem(problem_) {}
+  explicit TimeGAFactory(Problem &problem_) : GAFactory(problem_) {}
 
   ~TimeGAFactory() = default;
 
   GeneticAlgorithm make_ga(uint8_t tourRingSize, uint32_t stop,
-      uint8_t crossoverId, float crossRate, float mutRate)
+      const std::string &crossover, float crossRate, float mutRate)
   {
     // std::chrono::duration<uint32_t, std::ratio<1>> _time(stop);
-    stopCriteria = new eoTimeContinue<Chrom>(stop);
+    time_t remaining = stop > doneSeconds ? time_t(stop - doneSeconds) : 1;
+    stopCriteria = new eoTimeContinue<Chrom>(remaining);
 
-    select = eoDetTournamentSelect<Chrom>(tourRingSize);
+    select = TournamentSelection(tourRingSize);
     mutationOp = eoBitMutation<Chrom>(mutRate);
-    crossoverPtr = CrossoverFabric::create(crossoverId);
+    crossoverPtr = CrossoverFabric::create(crossover);
 
-    GeneticAlgorithm ga(problem,
+    GeneticAlgorithm ga(evaluationCounter,
         select, *crossoverPtr, crossRate, mutationOp, 1.0F, *stopCriteria);
     return ga;
   }
 
 private:
-  Problem &problem;
-  eoDetTournamentSelect<Chrom> select;
+  TournamentSelection select;
   eoQuadOp<Chrom> *crossoverPtr;
   eoBitMutation<Chrom> mutationOp;
   eoTimeContinue<Chrom> *stopCriteria;
@@ -103,39 +131,118 @@ private:
  */
 class EvaluationsGAFactory : public GAFactory {
 public:
-  explicit EvaluationsGAFactory(Problem &problem_)
-    : problem(problem_), evalFuncCounter((eoEvalFunc<Chrom>&)problem_) {}
+  explicit EvaluationsGAFactory(Problem &problem_) : GAFactory(problem_) {}
 
   ~EvaluationsGAFactory() = default;
 
   GeneticAlgorithm make_ga(uint8_t tourRingSize, uint32_t stop,
-      uint8_t crossoverId, float crossRate, float mutRate)
+      const std::string &crossover, float crossRate, float mutRate)
+  {
+    this->evaluationCounter.set_budget(stop);
+    this->stopCriteria = new BudgetContinue(this->evaluationCounter);
+
+    select = TournamentSelection(tourRingSize);
+    mutationOp = eoBitMutation<Chrom>(mutRate);
+    crossoverPtr = CrossoverFabric::create(crossover);
+
+    GeneticAlgorithm ga(evaluationCounter,
+        select, *crossoverPtr, crossRate, mutationOp, 1.0F, *stopCriteria);
+    return ga;
+  }
+
+private:
+  TournamentSelection select;
+  eoQuadOp<Chrom> *crossoverPtr;
+  eoBitMutation<Chrom> mutationOp;
+  BudgetContinue *stopCriteria;
+};
+
+
+
+/**
+ * Cria um Algoritmo Genético com um critério de parada composto (StopLimits):
+ * avaliações, gerações, tempo e custo alvo, o que for atingido primeiro.
+ * O argumento `stop` de make_ga limita as avaliações quando os limites
+ * dados não têm nenhum critério.
+ */
+class CombinedGAFactory : public GAFactory {
+public:
+  CombinedGAFactory(Problem &problem_, const StopLimits &limits_)
+    : GAFactory(problem_), limits(limits_) {}
+
+  ~CombinedGAFactory() = default;
+
+  GeneticAlgorithm make_ga(uint8_t tourRingSize, uint32_t stop,
+      const std::string &crossover, float crossRate, float mutRate)
   {
-    // TODO: Need change implementation of Problem to inherit from eoEvalFunc
-    // eoEvalFunc<Chrom> *problemEvalFunc = (eoEvalFunc<Chrom> *)&this->problem;
-    // this->evalFuncCounter = eoEvalFuncCounter(*problemEvalFunc);
-    this->stopCriteria = new eoEvalContinue<Chrom>(this->evalFuncCounter, stop);
+    this->stopCriteria = this->make_stop_criteria(stop);
 
-    select = eoDetTournamentSelect<Chrom>(tourRingSize);
+    select = TournamentSelection(tourRingSize);
     mutationOp = eoBitMutation<Chrom>(mutRate);
-    crossoverPtr = CrossoverFabric::create(crossoverId);
+    crossoverPtr = CrossoverFabric::create(crossover);
 
-    GeneticAlgorithm ga(evalFuncCounter,
+    GeneticAlgorithm ga(evaluationCounter,
         select, *crossoverPtr, crossRate, mutationOp, 1.0F, *stopCriteria);
     return ga;
   }
 
-  eoEvalFuncCounter<Chrom>& get_evalfunccounter() {
-    return this->evalFuncCounter;
+  /**
+   * O mesmo AG sobre uma população compacta (PackedPopulation), com as taxas
+   * dadas por cronogramas */
+  PackedGeneticAlgorithm make_packed_ga(uint8_t tourRingSize, uint32_t stop,
+      const std::string &crossover, const RateSchedule &crossRate,
+      const RateSchedule &mutRate)
+  {
+    this->stopCriteria = this->make_stop_criteria(stop);
+    crossoverPtr = CrossoverFabric::create(crossover);
+
+    return PackedGeneticAlgorithm(evaluationCounter, tourRingSize,
+        *crossoverPtr, crossRate, mutRate, *stopCriteria);
   }
 
+  /**
+   * AG steady-state com avaliação assíncrona por threads, com as taxas dadas
+   * por cronogramas */
+  AsyncGeneticAlgorithm make_async_ga(uint8_t tourRingSize, uint32_t stop,
+      const std::string &crossover, const RateSchedule &crossRate,
+      const RateSchedule &mutRate, const AsyncSettings &settings)
+  {
+    this->stopCriteria = this->make_stop_criteria(stop);
+    crossoverPtr = CrossoverFabric::create(crossover);
+
+    return AsyncGeneticAlgorithm(evaluationCounter, tourRingSize,
+        *crossoverPtr, crossRate, mutRate, *stopCriteria, settings);
+  }
+
+  /**
+   * Critério criado pelo último make_ga (ou make_packed_ga, make_async_ga),
+   * com o critério que disparou e o tempo até o alvo */
+  const StopCriteria *get_stop_criteria() const { return this->stopCriteria; }
+
 private:
-  Problem &problem;
-  eoDetTournamentSelect<Chrom> select;
+  StopLimits limits;
+  TournamentSelection select;
   eoQuadOp<Chrom> *crossoverPtr;
   eoBitMutation<Chrom> mutationOp;
-  eoEvalFuncCounter<Chrom> evalFuncCounter;
-  eoEvalContinue<Chrom> *stopCriteria;
+  StopCriteria *stopCriteria = nullptr;
+
+  StopCriteria *make_stop_criteria(uint32_t stop) {
+    StopLimits used = this->limits;
+    if (!used.evaluations and !used.generations and used.seconds <= 0
+        and !used.hasTarget) {
+      used.evaluations = stop;
+    }
+    if (used.hasTarget and used.targetOptimum) {
+      const double optimum = problem.known_optimum();
+      if (std::isnan(optimum)) {
+        throw std::invalid_argument("A instância não tem ótimo conhecido para target=opt");
+      }
+      used.target = optimum;
+      used.targetOptimum = false;
+    }
+    return new StopCriteria(used, this->evaluationCounter,
+        problem.is_minimization(), doneGenerations, doneSeconds);
+  }
 };
 
 #endif
@@ -3,12 +3,128 @@
 //
 
 #include "genetic_algorithm.h"
+#include <algorithm>
+#include <chrono>
 //#include <iostream>
 
-std::vector<Chrom> &GeneticAlgorithm::get_convergence() {
+std::vector<GeneticAlgorithm::Fitness> &GeneticAlgorithm::get_convergence() {
   return this->convergence;
 }
 
+uint32_t GeneticAlgorithm::get_generation() const {
+  return this->generation;
+}
+
+const PhaseTimer &GeneticAlgorithm::get_phase_timer() const {
+  return this->phaseTimer;
+}
+
+
+void GeneticAlgorithm::set_checkpoint(const std::string &filename, uint32_t every) {
+  this->checkpointFile = filename;
+  this->checkpointEvery = every;
+}
+
+void GeneticAlgorithm::restore(const Checkpoint &ckpt, eoPop<Chrom>& population) {
+  population = ckpt.population;
+  this->convergence = ckpt.convergence;
+  this->generation = ckpt.generation;
+  this->restoredSeconds = ckpt.elapsed_seconds;
+  this->evaluator.restore(ckpt.objective_calls, ckpt.repair_calls,
+      ckpt.cache_hits, ckpt.skipped);
+  Checkpoint::restore_rng(ckpt.rng_state);
+  this->restored = true;
+}
+
+void GeneticAlgorithm::save_checkpoint(const eoPop<Chrom>& population,
+    double elapsedSeconds)
+{
+  Checkpoint ckpt;
+  ckpt.generation = this->generation;
+  ckpt.elapsed_seconds = elapsedSeconds;
+  ckpt.objective_calls = this->evaluator.objective_calls();
+  ckpt.repair_calls = this->evaluator.repair_calls();
+  ckpt.cache_hits = this->evaluator.cache_hits();
+  ckpt.skipped = this->evaluator.skipped();
+  ckpt.convergence = this->convergence;
+  ckpt.rng_state = Checkpoint::capture_rng();
+  ckpt.population = population;
+  ckpt.save(this->checkpointFile);
+}
+
+void GeneticAlgorithm::set_rate_control(RateControl *rates_) {
+  this->rates = rates_;
+}
+
+void GeneticAlgorithm::set_restart_policy(RestartPolicy *restart_) {
+  this->restart = restart_;
+}
+
+void GeneticAlgorithm::set_local_search(LocalSearch *localSearch_) {
+  this->localSearch = localSearch_;
+}
+
+const AdaptiveCrossover *GeneticAlgorithm::get_adaptive() const {
+  return this->adaptive;
+}
+
+void GeneticAlgorithm::credit_operators(const eoPop<Chrom>& offspring)
+{
+	for (size_t i=0; i < this->pairArm.size(); i++) {
+		if (this->pairArm[i] < 0) continue;
+		const Chrom &child1 = offspring[2*i], &child2 = offspring[2*i+1];
+		if (child1.invalid() and child2.invalid()) continue;
+
+		Fitness child = child1.invalid() ? child2.fitness() : child1.fitness();
+		if (!child2.invalid()) child = std::max(child, child2.fitness());
+
+		// Relative improvement, so the credit does not depend on the scale of
+		// the objective; no improvement gives no credit
+		const Fitness parent = this->pairParentFitness[i];
+		double credit = 0.0;
+		if (child > parent) {
+			credit = parent > 0 ? (child - parent) / parent : 1.0;
+		}
+		this->adaptive->reward(this->pairArm[i], credit);
+	}
+	this->adaptive->end_generation();
+}
+
+void GeneticAlgorithm::select_offspring(eoPop<Chrom>& population,
+    eoPop<Chrom>& nextGen)
+{
+	const size_t popsize = population.size();
+	const size_t none = popsize;
+
+	// Only the indices of the parents are selected
+	if (this->tournament) {
+		this->tournament->select(population, popsize, parents);
+	} else {
+		select.setup(population);
+		parents.resize(popsize);
+		for (size_t i=0; i < popsize; i++) {
+			parents[i] = &select(population) - &population[0];
+		}
+	}
+	lastUse.assign(popsize, none);
+	for (size_t i=0; i < popsize; i++) {
+		lastUse[parents[i]] = i;
+	}
+
+	// Offspring are materialized in order, so every copy of a parent happens
+	// before its last use, which takes the genes (and the fitness) of the
+	// parent without copying them. The current population is replaced at the
+	// end of the generation, so the parents are no longer needed
+	nextGen.resize(popsize);
+	for (size_t i=0; i < popsize; i++) {
+		const size_t p = parents[i];
+		if (lastUse[p] == i) {
+			nextGen[i].swap(population[p]);
+		} else {
+			nextGen[i] = population[p];
+		}
+	}
+}
 
 void GeneticAlgorithm::operator()(eoPop<Chrom>& population)
 {
@@ -16,48 +132,122 @@ void GeneticAlgorithm::operator()(eoPop<Chrom>& population)
 	Chrom _elite;
   std::cout << "Stopper: " << this->stopCriteria.className() << std::endl;
 
-	// Clear convergence array
-  if (!this->convergence.empty()) {
+	// Clear convergence array, unless continuing a restored run
+  if (!this->restored) {
     this->convergence.clear();
+    this->generation = 0;
+    this->restoredSeconds = 0.0;
   }
+  this->restored = false;
+  this->phaseTimer.reset();
+  auto start = std::chrono::steady_clock::now();
 
 	// Main loop
 	do {
+		this->phaseTimer.start();
 		// Save current best individual
 		_elite = population.best_element();
+		this->phaseTimer.lap(PhaseTimer::elitism);
+
+		// Rates of this generation
+		if (this->rates) {
+			this->rates->update(this->generation, population);
+		}
+
 		// Select for next population
-		select(population, nextGen);
+		select_offspring(population, nextGen);
+		this->phaseTimer.lap(PhaseTimer::selection);
 
 		// Recombination step (crossover)
-		for (size_t i=0; i < (population.size()/2); i++) {
-			if (rng.flip(crossoverRate)) {
+		if (this->adaptive) {
+			this->pairArm.assign(nextGen.size()/2, -1);
+			this->pairParentFitness.resize(nextGen.size()/2);
+		}
+		for (size_t i=0; i < (nextGen.size()/2); i++) {
+			const double rate = this->rates ?
+					this->rates->crossover_rate(nextGen[2*i], nextGen[2*i+1]) : crossoverRate;
+			if (rng.flip(rate)) {
+				if (this->adaptive) {
+					const Chrom &p1 = nextGen[2*i], &p2 = nextGen[2*i+1];
+					this->pairParentFitness[i] = std::max(
+							p1.invalid() ? Fitness() : p1.fitness(),
+							p2.invalid() ? Fitness() : p2.fitness());
+				}
 				if (cross(nextGen[2*i], nextGen[2*i+1])) {
 					nextGen[2*i].invalidate(); nextGen[2*i+1].invalidate();
 				}
+				if (this->adaptive) {
+					this->pairArm[i] = this->adaptive->last_arm();
+				}
 			}
 		}
+		this->phaseTimer.lap(PhaseTimer::crossover);
 
 		// Mutation process step
 		for (size_t i=0; i < nextGen.size(); i++) {
 			if (rng.flip(mutationRate)) {
-				if (mutate(nextGen[i]))
+				const bool changed = this->rates ?
+						this->rates->mutate(nextGen[i]) : mutate(nextGen[i]);
+				if (changed)
 					nextGen[i].invalidate();
 			}
 		}
+		this->phaseTimer.lap(PhaseTimer::mutation);
+
+		// Repair (feasibility) step of the new individuals
+		for (Chrom &individual : nextGen) {
+			evaluator.repair(individual);
+		}
+		this->phaseTimer.lap(PhaseTimer::repair);
 
-		// Evaluate the new generation
+		// Evaluate the new generation. When the evaluation budget runs out in
+		// the middle of the generation, the remaining offspring are discarded
+		// and the last generation is smaller (the elite is still recovered)
+		for (Chrom &individual : nextGen) {
+			evaluator.evaluate(individual);
+		}
+		if (this->adaptive) {
+			credit_operators(nextGen);
+		}
+		this->phaseTimer.lap(PhaseTimer::evaluation);
+
+		// Memetic step on the best offspring (the crossover credit above only
+		// sees what the operators produced)
+		if (this->localSearch) {
+			this->localSearch->improve(nextGen, evaluator);
+			this->phaseTimer.lap(PhaseTimer::local_search);
+		}
+		if (evaluator.exhausted()) {
+			nextGen.erase(std::remove_if(nextGen.begin(), nextGen.end(),
+					[](const Chrom &c) { return c.invalid(); }), nextGen.end());
+		}
 		population.swap(nextGen);
-    for (Chrom &individual : population) {
-      problem(individual);
-    }
+		this->phaseTimer.lap(PhaseTimer::evaluation);
 
-		// Recovers the elite
-		auto _worseIt = population.it_worse_element();
-		*_worseIt = _elite;
+		// Recovers the elite (alone when no offspring was evaluated)
+		if (population.empty()) {
+			population.push_back(_elite);
+		} else {
+			auto _worseIt = population.it_worse_element();
+			*_worseIt = _elite;
+		}
     // std::cout << population.best_element().fitness() << std::endl;
 
 		// Save to convergence
-		this->convergence.push_back( population.best_element() );
+		this->convergence.push_back( population.best_element().fitness() );
+		this->phaseTimer.lap(PhaseTimer::elitism);
+
+		// The individuals created by a restart are evaluated like offspring
+		if (this->restart and
+				(*this->restart)(this->generation, population, evaluator)) {
+			this->phaseTimer.lap(PhaseTimer::evaluation);
+		}
+		this->generation++;
+
+		if (this->checkpointEvery > 0 and this->generation % this->checkpointEvery == 0) {
+			std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+			save_checkpoint(population, this->restoredSeconds + elapsed.count());
+		}
 	}
   while (stopCriteria(population));
 	nextGen.clear();
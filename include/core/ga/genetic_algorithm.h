@@ -7,6 +7,14 @@
 
 #include <paradiseo/eo/eoSGA.h>
 #include "problem.h"
+#include "phase_timer.h"
+#include "evaluation_counter.h"
+#include "checkpoint.h"
+#include "adaptive_crossover.h"
+#include "rate_control.h"
+#include "restart_policy.h"
+#include "local_search.h"
+#include "tournament_selection.h"
 
 class GeneticAlgorithm {
 public:
@@ -15,16 +23,18 @@ public:
 
 	// Default constructor
 	explicit GeneticAlgorithm(
-			eoEvalFunc<Chrom>& problem_,
+			EvaluationCounter& evaluator_,
 			eoSelectOne<Chrom> &selectOp_,
 			eoQuadOp<Chrom> &crossoverOp_,
 			const float crossoverRate_,
 			eoMonOp<Chrom> &mutationOp_,
 			const float mutationRate_,
 			eoContinue<Chrom> &continue_
-	) : problem(problem_),
+	) : evaluator(evaluator_),
 		select(selectOp_),
+		tournament(dynamic_cast<TournamentSelection*>(&selectOp_)),
 		cross(crossoverOp_),
+		adaptive(dynamic_cast<AdaptiveCrossover*>(&crossoverOp_)),
 		mutate(mutationOp_),
 		stopCriteria(continue_),
 		crossoverRate(crossoverRate_),
@@ -34,8 +44,18 @@ public:
 	// Default destructor
 	~GeneticAlgorithm() = default;
 
-  // Getter for the convergence vector
-  std::vector<Chrom> &get_convergence();
+  // Getter for the convergence vector (best fitness of each generation)
+  std::vector<Fitness> &get_convergence();
+
+  // Number of generations completed (including the ones restored from a
+  // checkpoint)
+  uint32_t get_generation() const;
+
+  // The adaptive crossover portfolio in use, or nullptr for a single operator
+  const AdaptiveCrossover *get_adaptive() const;
+
+  // Getter for the time spent in each phase of the last execution
+  const PhaseTimer &get_phase_timer() const;
 
 	// Main operator of the GA
 	// Gets a reference to a population object and evolve it
@@ -43,15 +63,69 @@ public:
 	// at end of each generation
 	virtual void operator()(eoPop<Chrom>& population);
 
+	// Controls the crossover and mutation rates during the run. While set,
+	// the crossover rate given in the constructor is not used and the
+	// mutation of the genes is done by the rate control instead of the
+	// mutation operator (nullptr restores the fixed rates)
+	void set_rate_control(RateControl *rates_);
+
+	// Restarts the population when the search stagnates, keeping only the
+	// best individuals (nullptr disables the restarts)
+	void set_restart_policy(RestartPolicy *restart_);
+
+	// Memetic step: improves the best offspring of each generation after
+	// their evaluation (nullptr disables it)
+	void set_local_search(LocalSearch *localSearch_);
+
+	// Writes a checkpoint to `filename` every `every` generations
+	void set_checkpoint(const std::string &filename, uint32_t every);
+
+	// Restores the state saved in a checkpoint, including the population.
+	// The next call to operator() continues that run instead of starting a
+	// new one
+	void restore(const Checkpoint &ckpt, eoPop<Chrom>& population);
+
 protected:
-	eoEvalFunc<Chrom>& problem;
-	eoSelectPerc<Chrom> select;
+	EvaluationCounter& evaluator;
+	eoSelectOne<Chrom>& select;
+	TournamentSelection *tournament;  // the selection, if it works on indices
 	eoInvalidateQuadOp<Chrom> cross;
+	AdaptiveCrossover *adaptive;
 	eoInvalidateMonOp<Chrom> mutate;
 	eoContinue<Chrom>& stopCriteria;
 	float crossoverRate;
 	float mutationRate;
-  std::vector<Chrom> convergence;
+	RateControl *rates = nullptr;
+	RestartPolicy *restart = nullptr;
+	LocalSearch *localSearch = nullptr;
+  std::vector<Fitness> convergence;
+  PhaseTimer phaseTimer;
+  uint32_t generation = 0;
+  double restoredSeconds = 0.0;  // evolution time before the restore
+  bool restored = false;
+  std::string checkpointFile;
+  uint32_t checkpointEvery = 0;
+
+  std::vector<size_t> parents;  // index of the parent of each offspring
+  std::vector<size_t> lastUse;  // last offspring that uses each parent
+
+  // Operator applied to each pair in the current generation (-1 if the pair
+  // was not crossed) and the best fitness of its parents, for the credit of
+  // the adaptive crossover
+  std::vector<int> pairArm;
+  std::vector<Fitness> pairParentFitness;
+
+  // Gives each operator of the adaptive crossover the improvement of the best
+  // offspring of each pair it produced over the best of the parents
+  void credit_operators(const eoPop<Chrom>& offspring);
+
+  // Selects the parents of the next generation by index (all at once with a
+  // TournamentSelection) and builds the offspring from them, copying the
+  // genes only when a parent is used again
+  void select_offspring(eoPop<Chrom>& population, eoPop<Chrom>& nextGen);
+
+  // Saves the state at the end of the current generation
+  void save_checkpoint(const eoPop<Chrom>& population, double elapsedSeconds);
 };
 
 #endif //CROSSOVERRESEARCH_GENETIC_ALGORITHM_H
@@ -0,0 +1,155 @@
+#include "linear_objective.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <core/utils/simd_dispatch.h>
+
+namespace {
+
+constexpr size_t CHUNK_BITS = 32;  // genes por bloco transposto
+
+/**
+ * Um kernel soma, para cada função k, os coeficientes dos genes 1 de `width`
+ * indivíduos. `lanes[c * width + r]` tem os genes 32c..32c+31 do indivíduo r
+ * e `out[k * width + r]` recebe a soma da função k do indivíduo r */
+struct Kernel {
+  const char *name;
+  size_t width;
+  void (*run)(const float *coef, size_t numFunctions, size_t paddedGenes,
+      const uint32_t *lanes, float *out);
+};
+
+void run_scalar(const float *coef, size_t numFunctions, size_t paddedGenes,
+    const uint32_t *lanes, float *out) {
+  const size_t nchunks = paddedGenes / CHUNK_BITS;
+  for (size_t k = 0; k < numFunctions; k++) {
+    const float *c = coef + k * paddedGenes;
+    float sum = 0.0f;
+    for (size_t ch = 0; ch < nchunks; ch++) {
+      for (uint32_t bits = lanes[ch]; bits; bits &= bits - 1) {
+        sum += c[ch * CHUNK_BITS + __builtin_ctz(bits)];
+      }
+    }
+    out[k] = sum;
+  }
+}
+
+#ifdef SIMD_DISPATCH_X86
+__attribute__((target("avx2")))
+void run_avx2(const float *coef, size_t numFunctions, size_t paddedGenes,
+    const uint32_t *lanes, float *out) {
+  const size_t nchunks = paddedGenes / CHUNK_BITS;
+  for (size_t k = 0; k < numFunctions; k++) {
+    const float *c = coef + k * paddedGenes;
+    __m256 acc = _mm256_setzero_ps();
+    for (size_t ch = 0; ch < nchunks; ch++) {
+      const __m256i bits = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(lanes + ch * 8));
+      if (_mm256_testz_si256(bits, bits)) continue;
+      const float *cc = c + ch * CHUNK_BITS;
+      __m256i bit = _mm256_set1_epi32(1);
+      for (size_t b = 0; b < CHUNK_BITS; b++) {
+        // Lanes com o gene 1 somam o coeficiente, as demais somam zero
+        const __m256i set = _mm256_cmpeq_epi32(_mm256_and_si256(bits, bit), bit);
+        acc = _mm256_add_ps(acc, _mm256_and_ps(_mm256_castsi256_ps(set),
+            _mm256_set1_ps(cc[b])));
+        bit = _mm256_add_epi32(bit, bit);
+      }
+    }
+    _mm256_storeu_ps(out + k * 8, acc);
+  }
+}
+
+__attribute__((target("avx512f")))
+void run_avx512(const float *coef, size_t numFunctions, size_t paddedGenes,
+    const uint32_t *lanes, float *out) {
+  const size_t nchunks = paddedGenes / CHUNK_BITS;
+  for (size_t k = 0; k < numFunctions; k++) {
+    const float *c = coef + k * paddedGenes;
+    __m512 acc = _mm512_setzero_ps();
+    for (size_t ch = 0; ch < nchunks; ch++) {
+      const __m512i bits = _mm512_loadu_si512(lanes + ch * 16);
+      if (!_mm512_test_epi32_mask(bits, bits)) continue;
+      const float *cc = c + ch * CHUNK_BITS;
+      for (size_t b = 0; b < CHUNK_BITS; b++) {
+        const __mmask16 set = _mm512_test_epi32_mask(bits,
+            _mm512_set1_epi32(int(1u << b)));
+        acc = _mm512_mask_add_ps(acc, set, acc, _mm512_set1_ps(cc[b]));
+      }
+    }
+    _mm512_storeu_ps(out + k * 16, acc);
+  }
+}
+#endif
+
+const Kernel scalarKernel{"scalar", 1, run_scalar};
+#ifdef SIMD_DISPATCH_X86
+const Kernel avx2Kernel{"avx2", 8, run_avx2};
+const Kernel avx512Kernel{"avx512", 16, run_avx512};
+#endif
+
+SimdDispatch<Kernel> &active() {
+#ifdef SIMD_DISPATCH_X86
+  static SimdDispatch<Kernel> kernels("LinearObjective", scalarKernel, &avx2Kernel, &avx512Kernel);
+#else
+  static SimdDispatch<Kernel> kernels("LinearObjective", scalarKernel, nullptr, nullptr);
+#endif
+  return kernels;
+}
+
+} // namespace
+
+LinearObjective::LinearObjective(size_t numGenes_)
+  : numGenes(numGenes_),
+    paddedGenes((numGenes_ + CHUNK_BITS - 1) / CHUNK_BITS * CHUNK_BITS) {}
+
+size_t LinearObjective::add(const std::vector<float> &coefficients_) {
+  if (coefficients_.size() != this->numGenes) {
+    throw std::invalid_argument("LinearObjective: número de coeficientes diferente do número de genes");
+  }
+  this->coefficients.insert(this->coefficients.end(), coefficients_.begin(),
+      coefficients_.end());
+  this->coefficients.resize(this->coefficients.size() + this->paddedGenes - this->numGenes, 0.0f);
+  return this->numFunctions++;
+}
+
+void LinearObjective::operator()(const PackedPopulation &pop,
+    const std::vector<size_t> &rows, std::vector<float> &sums) const {
+  const Kernel &kernel = active().get();
+  const size_t width = kernel.width;
+  const size_t nchunks = this->paddedGenes / CHUNK_BITS;
+  const size_t K = this->numFunctions;
+  sums.resize(rows.size() * K);
+  if (rows.empty() or K == 0) return;
+
+  // As linhas da população têm ao menos paddedGenes bits (o preenchimento é
+  // zero), e na ordem little-endian os blocos de 32 genes são as metades das
+  // palavras
+  std::vector<uint32_t> lanes(nchunks * width);
+  std::vector<float> out(K * width);
+  for (size_t first = 0; first < rows.size(); first += width) {
+    const size_t count = std::min(width, rows.size() - first);
+    if (count < width) std::fill(lanes.begin(), lanes.end(), 0u);
+    for (size_t r = 0; r < count; r++) {
+      const auto *row = reinterpret_cast<const unsigned char*>(pop.row(rows[first + r]));
+      for (size_t ch = 0; ch < nchunks; ch++) {
+        std::memcpy(&lanes[ch * width + r], row + ch * sizeof(uint32_t), sizeof(uint32_t));
+      }
+    }
+    kernel.run(this->coefficients.data(), K, this->paddedGenes, lanes.data(),
+        out.data());
+    for (size_t r = 0; r < count; r++) {
+      for (size_t k = 0; k < K; k++) {
+        sums[(first + r) * K + k] = out[k * width + r];
+      }
+    }
+  }
+}
+
+const char *LinearObjective::kernel() {
+  return active().name();
+}
+
+void LinearObjective::set_kernel(const std::string &name) {
+  active().set(name);
+}
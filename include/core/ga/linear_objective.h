@@ -0,0 +1,56 @@
+#ifndef CROSSOVERRESEARCH_LINEAR_OBJECTIVE_H
+#define CROSSOVERRESEARCH_LINEAR_OBJECTIVE_H
+
+#include <string>
+#include <vector>
+#include "packed_population.h"
+
+/**
+ * @class LinearObjective
+ * Funções lineares dos genes (somas de coeficientes dos genes 1), calculadas
+ * para vários indivíduos de uma PackedPopulation de uma vez. Serve para
+ * objetivos e restrições como o custo da cobertura de conjuntos ou o lucro e
+ * os consumos da mochila multidimensional.
+ *
+ * Os indivíduos são processados em lotes, um por lane de SIMD: para cada gene
+ * o coeficiente é somado nas lanes cujo bit do gene é 1. O kernel é escolhido
+ * em tempo de execução conforme a CPU (AVX-512 com 16 indivíduos por vez,
+ * AVX2 com 8, ou escalar, que percorre os bits 1 de cada indivíduo). As somas
+ * são feitas em float na ordem dos genes em todos os kernels, então os
+ * resultados são idênticos entre eles.
+ */
+class LinearObjective {
+public:
+  explicit LinearObjective(size_t numGenes = 0);
+
+  /**
+   * Acrescenta uma função (um coeficiente por gene) e retorna o índice dela
+   * nas somas */
+  size_t add(const std::vector<float> &coefficients);
+
+  // Número de funções
+  size_t size() const { return this->numFunctions; }
+
+  /**
+   * Calcula as funções para as linhas `rows` de `pop`: sums[r * size() + k]
+   * é a função k da linha rows[r] */
+  void operator()(const PackedPopulation &pop, const std::vector<size_t> &rows,
+      std::vector<float> &sums) const;
+
+  /**
+   * Kernel em uso: "avx512", "avx2" ou "scalar" */
+  static const char *kernel();
+
+  /**
+   * Força um kernel (ex.: para comparar nos benchmarks); "auto" volta à
+   * escolha pela CPU. Um kernel que a CPU não suporta é rejeitado */
+  static void set_kernel(const std::string &name);
+
+private:
+  size_t numGenes;
+  size_t paddedGenes;  // numGenes arredondado para blocos de 32 genes
+  size_t numFunctions = 0;
+  std::vector<float> coefficients;  // função x gene, zero no preenchimento
+};
+
+#endif //CROSSOVERRESEARCH_LINEAR_OBJECTIVE_H
@@ -0,0 +1,71 @@
+#include "local_search.h"
+#include "crossover_fabric.h"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+LocalSearch::Budget LocalSearch::Budget::parse(const std::string &text) {
+  // Mesmo formato de parâmetros dos operadores de crossover
+  const CrossoverSpec spec = CrossoverSpec::parse("local-search:" + text);
+  spec.check_params({"best", "moves", "time"});
+  Budget budget;
+  const double best = spec.get("best", budget.best);
+  const double moves = spec.get("moves", budget.moves);
+  budget.milliseconds = spec.get("time", budget.milliseconds);
+  if (best < 1 or moves < 0 or budget.milliseconds < 0) {
+    throw std::invalid_argument("local-search: best deve ser >= 1 e moves e "
+        "time não podem ser negativos");
+  }
+  budget.best = uint32_t(best);
+  budget.moves = (unsigned long) moves;
+  return budget;
+}
+
+bool LocalSearch::spend() {
+  if (this->exhausted) return false;
+  this->counter->count_moves(1);
+
+  if (this->budget.moves > 0 and --this->movesLeft == 0) {
+    this->exhausted = true;
+  }
+  // O relógio é consultado a cada 64 movimentos
+  if (this->budget.milliseconds > 0 and this->counter->local_search_moves() % 64 == 0
+      and std::chrono::steady_clock::now() >= this->deadline) {
+    this->exhausted = true;
+  }
+  return true;
+}
+
+void LocalSearch::improve(eoPop<Chrom> &offspring, EvaluationCounter &evaluator) {
+  std::vector<size_t> order;
+  for (size_t i = 0; i < offspring.size(); i++) {
+    if (!offspring[i].invalid()) order.push_back(i);
+  }
+  const size_t best = std::min<size_t>(this->budget.best, order.size());
+  std::partial_sort(order.begin(), order.begin() + best, order.end(),
+      [&](size_t a, size_t b) {
+        return offspring[a].fitness() > offspring[b].fitness();
+      });
+
+  this->counter = &evaluator;
+  this->movesLeft = this->budget.moves;
+  this->exhausted = false;
+  this->deadline = std::chrono::steady_clock::now()
+      + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double, std::milli>(this->budget.milliseconds));
+
+  Chrom candidate;
+  for (size_t k = 0; k < best and !this->exhausted; k++) {
+    Chrom &child = offspring[order[k]];
+    candidate = child;
+    if (!this->search(candidate)) continue;
+
+    candidate.invalidate();
+    evaluator.evaluate(candidate);
+    if (candidate.invalid()) break;  // orçamento de avaliações esgotado
+    if (candidate.fitness() >= child.fitness()) {
+      child.swap(candidate);
+      this->improvedCount++;
+    }
+  }
+}
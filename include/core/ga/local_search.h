@@ -0,0 +1,67 @@
+#ifndef CROSSOVERRESEARCH_LOCAL_SEARCH_H
+#define CROSSOVERRESEARCH_LOCAL_SEARCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "encoding.h"
+#include "evaluation_counter.h"
+
+/**
+ * @class LocalSearch
+ * Etapa memética do GeneticAlgorithm: a cada geração os `best` melhores
+ * filhos já avaliados passam por uma busca local específica do problema
+ * (Problem::create_local_search). A busca trabalha sobre uma cópia; se ela
+ * muda os genes, a cópia é reavaliada pelo EvaluationCounter (consumindo o
+ * orçamento de avaliações) e só substitui o filho se não for pior.
+ *
+ * O esforço por geração é limitado por um número de movimentos e/ou por um
+ * tempo, descritos como "best=5,moves=2000,time=10" (time em milisegundos;
+ * moves ou time iguais a 0 não limitam). Cada movimento examinado pela busca
+ * conta como um movimento, e o total vai para o EvaluationCounter.
+ */
+class LocalSearch {
+public:
+  struct Budget {
+    uint32_t best = 1;           // filhos melhorados por geração
+    unsigned long moves = 1000;  // movimentos por geração
+    double milliseconds = 0.0;   // tempo por geração
+
+    static Budget parse(const std::string &text);
+  };
+
+  virtual ~LocalSearch() = default;
+
+  void set_budget(const Budget &budget_) { this->budget = budget_; }
+  const Budget &get_budget() const { return this->budget; }
+
+  /**
+   * Aplica a busca aos melhores filhos válidos de `offspring` */
+  void improve(eoPop<Chrom> &offspring, EvaluationCounter &evaluator);
+
+  // Filhos substituídos por uma versão melhor desde o início da execução
+  unsigned long improved() const { return this->improvedCount; }
+
+  virtual std::string className() const { return "LocalSearch"; }
+
+protected:
+  /**
+   * Melhora os genes de um cromossomo reparado e avaliado, chamando spend()
+   * antes de examinar cada movimento e parando quando ele retornar false. O
+   * cromossomo deve continuar factível. Retorna true se algum gene mudou */
+  virtual bool search(Chrom &chrom) = 0;
+
+  /**
+   * Consome um movimento do orçamento da geração; false se ele acabou */
+  bool spend();
+
+private:
+  Budget budget;
+  unsigned long movesLeft = 0;
+  std::chrono::steady_clock::time_point deadline;
+  EvaluationCounter *counter = nullptr;
+  unsigned long improvedCount = 0;
+  bool exhausted = false;
+};
+
+#endif //CROSSOVERRESEARCH_LOCAL_SEARCH_H
@@ -0,0 +1,61 @@
+#include "packed_bits.h"
+#include <cstring>
+
+// A libstdc++ guarda os bits de um vector<bool> em palavras de 64 bits na
+// mesma ordem usada aqui, então as palavras podem ser copiadas inteiras
+#if defined(__GLIBCXX__)
+#define PACKED_BITS_WORD_COPY 1
+static_assert(sizeof(std::_Bit_type) == sizeof(packed::word_t),
+    "palavra do vector<bool> diferente de word_t");
+#endif
+
+void packed::pack(const Chrom &chrom, word_t *out) {
+  const size_t nbits = chrom.size();
+  const size_t nwords = num_words(nbits);
+#ifdef PACKED_BITS_WORD_COPY
+  if (nwords) {
+    std::memcpy(out, chrom.begin()._M_p, nwords * sizeof(word_t));
+    // Os bits depois do fim do vector<bool> não têm valor definido
+    if (nbits % WORD_BITS) {
+      out[nwords - 1] &= ~word_t(0) >> (WORD_BITS - nbits % WORD_BITS);
+    }
+  }
+#else
+  std::memset(out, 0, nwords * sizeof(word_t));
+  for (size_t i = 0; i < nbits; i++) {
+    if (chrom[i]) {
+      out[i / WORD_BITS] |= word_t(1) << (i % WORD_BITS);
+    }
+  }
+#endif
+}
+
+void packed::pack(const Chrom &chrom, std::vector<word_t> &out) {
+  out.resize(num_words(chrom.size()));
+  pack(chrom, out.data());
+}
+
+void packed::unpack(const word_t *words, Chrom &chrom) {
+  const size_t nbits = chrom.size();
+#ifdef PACKED_BITS_WORD_COPY
+  if (nbits) {
+    std::memcpy(chrom.begin()._M_p, words, num_words(nbits) * sizeof(word_t));
+  }
+#else
+  for (size_t i = 0; i < nbits; i++) {
+    chrom[i] = (words[i / WORD_BITS] >> (i % WORD_BITS)) & 1;
+  }
+#endif
+}
+
+uint64_t packed::hash(const word_t *words, size_t nwords) {
+  // Mistura no estilo do splitmix64 aplicada palavra a palavra
+  uint64_t h = 0x9E3779B97F4A7C15ULL ^ nwords;
+  for (size_t i = 0; i < nwords; i++) {
+    uint64_t z = words[i] + 0x9E3779B97F4A7C15ULL * (i + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    h = (h ^ (z ^ (z >> 31))) * 0x100000001B3ULL;
+  }
+  return h ^ (h >> 32);
+}
@@ -0,0 +1,44 @@
+#ifndef CROSSOVERRESEARCH_PACKED_BITS_H
+#define CROSSOVERRESEARCH_PACKED_BITS_H
+
+#include <cstdint>
+#include <vector>
+#include "encoding.h"
+
+/**
+ * Conversões entre um cromossomo e sua representação compacta em palavras de
+ * 64 bits. O gene i fica no bit (i % 64) da palavra (i / 64) e os bits que
+ * sobram na última palavra são sempre zero, então dois cromossomos iguais têm
+ * sempre as mesmas palavras.
+ */
+namespace packed {
+
+using word_t = uint64_t;
+constexpr size_t WORD_BITS = 64;
+
+// Número de palavras necessárias para guardar `nbits` genes
+inline size_t num_words(size_t nbits) {
+  return (nbits + WORD_BITS - 1) / WORD_BITS;
+}
+
+/**
+ * Escreve os genes de um cromossomo em `out` (redimensionado se preciso) */
+void pack(const Chrom &chrom, std::vector<word_t> &out);
+
+/**
+ * Escreve os genes de um cromossomo nas num_words(chrom.size()) primeiras
+ * palavras de `out` */
+void pack(const Chrom &chrom, word_t *out);
+
+/**
+ * Copia as palavras de volta para os genes do cromossomo, que já deve ter o
+ * tamanho correto */
+void unpack(const word_t *words, Chrom &chrom);
+
+/**
+ * Hash de uma sequência de palavras */
+uint64_t hash(const word_t *words, size_t nwords);
+
+} // namespace packed
+
+#endif //CROSSOVERRESEARCH_PACKED_BITS_H
@@ -0,0 +1,206 @@
+#include "packed_crossover.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <paradiseo/eo/utils/eoRNG.h>
+
+using packed::WORD_BITS;
+using packed::num_words;
+
+bool PackedCrossover::operator()(Chrom &chrom1, Chrom &chrom2) {
+  if (chrom1.size() != chrom2.size()) {
+    throw std::runtime_error("PackedCrossover: chromosomes of different sizes");
+  }
+  const size_t nbits = chrom1.size();
+  const size_t nwords = num_words(nbits);
+
+  packed::pack(chrom1, this->words1);
+  packed::pack(chrom2, this->words2);
+  this->diff.resize(nwords);
+  for (size_t w = 0; w < nwords; w++) {
+    this->diff[w] = this->words1[w] ^ this->words2[w];
+  }
+  this->mask.assign(nwords, 0);
+  this->make_mask(this->diff, nbits, this->mask);
+
+  // Só os bits diferentes dentro da máscara precisam ser trocados, e trocar
+  // dois bits diferentes é o mesmo que inverter os dois
+  bool changed = false;
+  for (size_t w = 0; w < nwords; w++) {
+    word_t swap = this->diff[w] & this->mask[w];
+    changed |= swap != 0;
+    while (swap) {
+      const size_t i = w * WORD_BITS + __builtin_ctzll(swap);
+      chrom1[i] = !chrom1[i];
+      chrom2[i] = !chrom2[i];
+      swap &= swap - 1;
+    }
+  }
+  return changed;
+}
+
+bool PackedCrossover::cross_words(word_t *words1, word_t *words2,
+    size_t nbits) {
+  const size_t nwords = num_words(nbits);
+  this->diff.resize(nwords);
+  for (size_t w = 0; w < nwords; w++) {
+    this->diff[w] = words1[w] ^ words2[w];
+  }
+  this->mask.assign(nwords, 0);
+  this->make_mask(this->diff, nbits, this->mask);
+
+  word_t changed = 0;
+  for (size_t w = 0; w < nwords; w++) {
+    const word_t swap = this->diff[w] & this->mask[w];
+    words1[w] ^= swap;
+    words2[w] ^= swap;
+    changed |= swap;
+  }
+  return changed != 0;
+}
+
+void PackedCrossover::set_range(std::vector<word_t> &mask, size_t from,
+    size_t to) {
+  if (from >= to) return;
+  const size_t first = from / WORD_BITS, last = (to - 1) / WORD_BITS;
+  const word_t head = ~word_t(0) << (from % WORD_BITS);
+  const word_t tail = ~word_t(0) >> (WORD_BITS - 1 - (to - 1) % WORD_BITS);
+  if (first == last) {
+    mask[first] |= head & tail;
+    return;
+  }
+  mask[first] |= head;
+  for (size_t w = first + 1; w < last; w++) {
+    mask[w] = ~word_t(0);
+  }
+  mask[last] |= tail;
+}
+
+void PackedCrossover::alternate(const std::vector<size_t> &cuts, size_t nbits,
+    std::vector<word_t> &mask) {
+  for (size_t c = 0; c < cuts.size(); c += 2) {
+    const size_t to = c + 1 < cuts.size() ? cuts[c + 1] : nbits;
+    set_range(mask, cuts[c], to);
+  }
+}
+
+void HUXCrossover::make_mask(const std::vector<word_t> &diff, size_t nbits,
+    std::vector<word_t> &mask) {
+  size_t remaining = 0;
+  for (word_t w : diff) {
+    remaining += __builtin_popcountll(w);
+  }
+
+  // Amostragem sequencial: cada posição diferente entra com probabilidade
+  // (faltam escolher) / (posições restantes), o que escolhe exatamente a
+  // metade com todos os subconjuntos igualmente prováveis
+  size_t needed = remaining / 2;
+  for (size_t w = 0; w < diff.size() && needed > 0; w++) {
+    word_t bits = diff[w];
+    while (bits && needed > 0) {
+      const word_t lowest = bits & (~bits + 1);
+      if (rng.random(remaining) < needed) {
+        mask[w] |= lowest;
+        needed--;
+      }
+      remaining--;
+      bits ^= lowest;
+    }
+  }
+}
+
+void ShuffleCrossover::make_mask(const std::vector<word_t> &diff, size_t nbits,
+    std::vector<word_t> &mask) {
+  if (nbits < 2) return;
+  const size_t cut = 1 + rng.random(nbits - 1);
+  const size_t swapped = nbits - cut;
+
+  // Sorteia por rejeição o menor dos dois conjuntos (o das posições trocadas
+  // ou o das mantidas), então o custo esperado é O(min(m, n - m))
+  const bool complement = swapped > nbits / 2;
+  size_t picks = complement ? nbits - swapped : swapped;
+  if (complement) {
+    set_range(mask, 0, nbits);
+  }
+  while (picks > 0) {
+    const size_t i = rng.random(nbits);
+    const word_t bit = word_t(1) << (i % WORD_BITS);
+    const bool marked = mask[i / WORD_BITS] & bit;
+    if (marked == complement) {
+      mask[i / WORD_BITS] ^= bit;
+      picks--;
+    }
+  }
+}
+
+ReducedSurrogateCrossover::ReducedSurrogateCrossover(uint numPoints)
+  : numPoints(numPoints) {
+  if (numPoints == 0) {
+    throw std::logic_error("ReducedSurrogateCrossover: 0 cut points!");
+  }
+}
+
+void ReducedSurrogateCrossover::make_mask(const std::vector<word_t> &diff,
+    size_t nbits, std::vector<word_t> &mask) {
+  size_t ndiff = 0;
+  for (word_t w : diff) {
+    ndiff += __builtin_popcountll(w);
+  }
+  if (ndiff < 2) return;
+
+  // Um corte de posto r fica logo antes da r-ésima posição diferente
+  // (r em [1, ndiff - 1]), então sempre separa duas posições diferentes
+  const size_t npoints = std::min<size_t>(this->numPoints, ndiff - 1);
+  this->ranks.clear();
+  while (this->ranks.size() < npoints) {
+    const size_t r = 1 + rng.random(ndiff - 1);
+    if (std::find(this->ranks.begin(), this->ranks.end(), r) == this->ranks.end()) {
+      this->ranks.push_back(r);
+    }
+  }
+  std::sort(this->ranks.begin(), this->ranks.end());
+
+  // Converte os postos em posições numa única passada pelas palavras
+  this->cuts.clear();
+  size_t seen = 0, next = 0;
+  for (size_t w = 0; w < diff.size() && next < npoints; w++) {
+    word_t bits = diff[w];
+    while (next < npoints
+        && this->ranks[next] < seen + __builtin_popcountll(bits)) {
+      for (size_t skip = this->ranks[next] - seen; skip > 0; skip--) {
+        bits &= bits - 1;
+        seen++;
+      }
+      this->cuts.push_back(w * WORD_BITS + __builtin_ctzll(bits));
+      next++;
+    }
+    seen += __builtin_popcountll(bits);
+  }
+  alternate(this->cuts, nbits, mask);
+}
+
+SegmentedCrossover::SegmentedCrossover(double switchRate)
+  : switchRate(switchRate) {
+  if (switchRate <= 0.0 || switchRate > 1.0) {
+    throw std::logic_error("SegmentedCrossover: switch rate must be in (0, 1]");
+  }
+}
+
+void SegmentedCrossover::make_mask(const std::vector<word_t> &diff,
+    size_t nbits, std::vector<word_t> &mask) {
+  // Cada posição em [1, nbits) é um corte com probabilidade switchRate; a
+  // distância até o próximo corte é geométrica
+  const double logq = std::log1p(-this->switchRate);
+  this->cuts.clear();
+  size_t pos = 0;
+  while (true) {
+    double gap = 1.0;
+    if (this->switchRate < 1.0) {
+      gap += std::floor(std::log1p(-rng.uniform()) / logq);
+    }
+    if (gap >= static_cast<double>(nbits - pos)) break;
+    pos += static_cast<size_t>(gap);
+    this->cuts.push_back(pos);
+  }
+  alternate(this->cuts, nbits, mask);
+}
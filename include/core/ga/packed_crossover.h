@@ -0,0 +1,114 @@
+#ifndef CROSSOVERRESEARCH_PACKED_CROSSOVER_H
+#define CROSSOVERRESEARCH_PACKED_CROSSOVER_H
+
+#include <string>
+#include <vector>
+#include <paradiseo/eo/eoOp.h>
+#include "packed_bits.h"
+
+/**
+ * @class PackedCrossover
+ * Base dos operadores de crossover implementados sobre as palavras de 64 bits
+ * dos pais (ver packed_bits.h).
+ *
+ * A subclasse só constrói uma máscara com as posições que devem ser trocadas
+ * entre os pais. Posições onde os pais são iguais não mudam nada, então a
+ * troca é feita apenas nos bits de (pai1 XOR pai2) que estão na máscara, e os
+ * genes são alterados um a um somente nessas posições.
+ */
+class PackedCrossover : public eoQuadOp<Chrom> {
+public:
+  using word_t = packed::word_t;
+
+  bool operator()(Chrom &chrom1, Chrom &chrom2) override;
+
+  /**
+   * O mesmo cruzamento aplicado diretamente a dois cromossomos compactados
+   * com `nbits` genes (ex.: linhas de uma PackedPopulation) */
+  bool cross_words(word_t *words1, word_t *words2, size_t nbits);
+
+protected:
+  /**
+   * Marca em `mask` (já zerada, com num_words(nbits) palavras) as posições a
+   * serem trocadas. `diff` tem as posições em que os pais diferem */
+  virtual void make_mask(const std::vector<word_t> &diff, size_t nbits,
+      std::vector<word_t> &mask) = 0;
+
+  // Marca os bits [from, to) de `mask`
+  static void set_range(std::vector<word_t> &mask, size_t from, size_t to);
+
+  // Marca segmentos alternados a partir de posições de corte em ordem
+  // crescente: [cuts[0], cuts[1]), [cuts[2], cuts[3]), ... até nbits
+  static void alternate(const std::vector<size_t> &cuts, size_t nbits,
+      std::vector<word_t> &mask);
+
+private:
+  std::vector<word_t> words1, words2, diff, mask;
+};
+
+/**
+ * Half-Uniform Crossover (HUX): troca exatamente metade dos bits em que os
+ * pais diferem, escolhidos ao acaso */
+class HUXCrossover : public PackedCrossover {
+public:
+  std::string className() const { return "HUXCrossover"; }
+
+protected:
+  void make_mask(const std::vector<word_t> &diff, size_t nbits,
+      std::vector<word_t> &mask) override;
+};
+
+/**
+ * Shuffle crossover: embaralha as posições, aplica um ponto de corte e
+ * desfaz o embaralhamento. É equivalente a trocar um subconjunto aleatório de
+ * n - k posições, com o corte k uniforme em [1, n - 1], que é o que se faz
+ * aqui sem gerar a permutação */
+class ShuffleCrossover : public PackedCrossover {
+public:
+  std::string className() const { return "ShuffleCrossover"; }
+
+protected:
+  void make_mask(const std::vector<word_t> &diff, size_t nbits,
+      std::vector<word_t> &mask) override;
+};
+
+/**
+ * N pontos de corte com substituto reduzido (reduced surrogate): os cortes
+ * são escolhidos somente entre posições em que os pais diferem, então todo
+ * corte produz filhos diferentes dos pais */
+class ReducedSurrogateCrossover : public PackedCrossover {
+public:
+  explicit ReducedSurrogateCrossover(uint numPoints);
+
+  std::string className() const { return "ReducedSurrogateCrossover"; }
+
+protected:
+  void make_mask(const std::vector<word_t> &diff, size_t nbits,
+      std::vector<word_t> &mask) override;
+
+private:
+  uint numPoints;
+  std::vector<size_t> ranks, cuts;
+};
+
+/**
+ * Crossover segmentado: número variável de pontos de corte, com cada posição
+ * sendo um corte com probabilidade `switchRate`. As distâncias entre cortes
+ * são sorteadas de uma distribuição geométrica, então o custo é proporcional
+ * ao número de cortes e não ao tamanho do cromossomo */
+class SegmentedCrossover : public PackedCrossover {
+public:
+  explicit SegmentedCrossover(double switchRate = 0.2);
+
+  std::string className() const { return "SegmentedCrossover"; }
+
+protected:
+  void make_mask(const std::vector<word_t> &diff, size_t nbits,
+      std::vector<word_t> &mask) override;
+
+private:
+  double switchRate;
+  std::vector<size_t> cuts;
+};
+
+#endif //CROSSOVERRESEARCH_PACKED_CROSSOVER_H
@@ -0,0 +1,163 @@
+#include "packed_genetic_algorithm.h"
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <paradiseo/eo/utils/eoRNG.h>
+#include "adaptive_crossover.h"
+
+PackedGeneticAlgorithm::PackedGeneticAlgorithm(
+    EvaluationCounter &evaluator_,
+    uint32_t tourRingSize_,
+    eoQuadOp<Chrom> &crossoverOp_,
+    const RateSchedule &crossoverRate_,
+    const RateSchedule &mutationRate_,
+    StopCriteria &continue_)
+  : evaluator(evaluator_),
+    selection(tourRingSize_),
+    cross(crossoverOp_),
+    packedCross(dynamic_cast<PackedCrossover*>(&crossoverOp_)),
+    crossoverRate(crossoverRate_),
+    mutationRate(mutationRate_),
+    stopCriteria(continue_)
+{
+	if (dynamic_cast<AdaptiveCrossover*>(&crossoverOp_)) {
+		throw std::invalid_argument("O crossover adaptativo não pode ser usado com a população compacta");
+	}
+	if (crossoverRate_.needs_entropy() or mutationRate_.needs_entropy()) {
+		throw std::invalid_argument("Cronogramas por diversidade não podem ser usados com a população compacta");
+	}
+}
+
+std::vector<PackedGeneticAlgorithm::Fitness> &PackedGeneticAlgorithm::get_convergence() {
+  return this->convergence;
+}
+
+uint32_t PackedGeneticAlgorithm::get_generation() const {
+  return this->generation;
+}
+
+const PhaseTimer &PackedGeneticAlgorithm::get_phase_timer() const {
+  return this->phaseTimer;
+}
+
+bool PackedGeneticAlgorithm::cross_rows(size_t i, size_t j)
+{
+	const size_t nbits = this->nextGen.num_genes();
+	if (this->packedCross) {
+		return this->packedCross->cross_words(this->nextGen.row(i),
+				this->nextGen.row(j), nbits);
+	}
+	this->nextGen.store(i, this->scratch1);
+	this->nextGen.store(j, this->scratch2);
+	if (!this->cross(this->scratch1, this->scratch2)) return false;
+	this->nextGen.load(i, this->scratch1);
+	this->nextGen.load(j, this->scratch2);
+	return true;
+}
+
+bool PackedGeneticAlgorithm::mutate_row(size_t i, double rate)
+{
+	const size_t n = this->nextGen.num_genes();
+	if (rate <= 0.0 or n == 0) return false;
+
+	packed::word_t *row = this->nextGen.row(i);
+	if (rate >= 1.0) {
+		const size_t nwords = packed::num_words(n);
+		for (size_t w = 0; w < nwords; w++) row[w] = ~row[w];
+		if (n % packed::WORD_BITS) {
+			row[nwords - 1] &= ~packed::word_t(0) >> (packed::WORD_BITS - n % packed::WORD_BITS);
+		}
+		return true;
+	}
+
+	// Geometric distance to the next flipped gene, as in BitFlipMutation
+	const double logq = std::log1p(-rate);
+	bool changed = false;
+	double pos = std::floor(std::log1p(-rng.uniform()) / logq);
+	while (pos < n) {
+		this->nextGen.flip(i, size_t(pos));
+		changed = true;
+		pos += 1.0 + std::floor(std::log1p(-rng.uniform()) / logq);
+	}
+	return changed;
+}
+
+void PackedGeneticAlgorithm::operator()(PackedPopulation &population)
+{
+	const size_t numGenes = population.num_genes();
+	this->nextGen = PackedPopulation(numGenes);
+	this->elite = PackedPopulation(numGenes, 1);
+	std::cout << "Stopper: " << this->stopCriteria.className()
+	          << " (população compacta, " << population.memory_bytes() / 1048576.0
+	          << " MB)" << std::endl;
+
+	this->convergence.clear();
+	this->generation = 0;
+	this->phaseTimer.reset();
+
+	bool running = true;
+	while (running) {
+		this->phaseTimer.start();
+		// Save current best individual
+		this->elite.copy_row(0, population, population.best());
+		this->phaseTimer.lap(PhaseTimer::elitism);
+
+		// Selection: tournaments on the fitness array, copying only the rows
+		// of the winners
+		const size_t popsize = population.size();
+		this->selection.select(population.fitness_data(), popsize, popsize,
+				this->parents);
+		this->nextGen.resize(popsize);
+		for (size_t i = 0; i < popsize; i++) {
+			this->nextGen.copy_row(i, population, this->parents[i]);
+		}
+		this->phaseTimer.lap(PhaseTimer::selection);
+
+		// Recombination step (crossover)
+		const double xrate = this->crossoverRate.value(this->generation, 0.0);
+		for (size_t i = 0; i + 1 < popsize; i += 2) {
+			if (rng.flip(xrate) and this->cross_rows(i, i + 1)) {
+				this->nextGen.invalidate(i);
+				this->nextGen.invalidate(i + 1);
+			}
+		}
+		this->phaseTimer.lap(PhaseTimer::crossover);
+
+		// Mutation process step
+		const double mrate = this->mutationRate.value(this->generation, 0.0);
+		for (size_t i = 0; i < popsize; i++) {
+			if (this->mutate_row(i, mrate)) this->nextGen.invalidate(i);
+		}
+		this->phaseTimer.lap(PhaseTimer::mutation);
+
+		// Repair and evaluation of the new individuals, in one batch when the
+		// problem supports it (both are timed as evaluation). When the budget
+		// runs out the remaining offspring are discarded
+		this->pending.clear();
+		for (size_t i = 0; i < popsize; i++) {
+			if (this->nextGen.invalid(i)) this->pending.push_back(i);
+		}
+		this->evaluator.evaluate_rows(this->nextGen, this->pending);
+		if (this->evaluator.exhausted()) {
+			this->nextGen.remove_invalid();
+		}
+		population.swap(this->nextGen);
+		this->phaseTimer.lap(PhaseTimer::evaluation);
+
+		// Recovers the elite
+		if (population.empty()) {
+			population.resize(1);
+			population.copy_row(0, this->elite, 0);
+		} else {
+			population.copy_row(population.worst(), this->elite, 0);
+		}
+
+		// Save to convergence
+		const Fitness best = population.fitness(population.best());
+		this->convergence.push_back(best);
+		this->phaseTimer.lap(PhaseTimer::elitism);
+		this->generation++;
+
+		running = this->stopCriteria(best);
+	}
+}
@@ -0,0 +1,85 @@
+#ifndef CROSSOVERRESEARCH_PACKED_GENETIC_ALGORITHM_H
+#define CROSSOVERRESEARCH_PACKED_GENETIC_ALGORITHM_H
+
+#include <cstdint>
+#include <vector>
+#include <paradiseo/eo/eoOp.h>
+#include "packed_population.h"
+#include "packed_crossover.h"
+#include "evaluation_counter.h"
+#include "stop_criteria.h"
+#include "rate_control.h"
+#include "phase_timer.h"
+#include "tournament_selection.h"
+
+/**
+ * @class PackedGeneticAlgorithm
+ * The generational GA of GeneticAlgorithm (tournament selection, crossover,
+ * bit-flip mutation, repair, evaluation and elitism) over a PackedPopulation,
+ * for populations too large to keep as one eoPop of separate chromosomes.
+ *
+ * Selection runs the tournaments of a whole generation on the fitness array
+ * (TournamentSelection) and copies the rows of the winners into the next
+ * generation; operators derived from PackedCrossover cross the rows in
+ * place, and only the other crossovers see a Chrom, unpacked into a reused
+ * scratch chromosome. The offspring of a generation are evaluated together
+ * by EvaluationCounter::evaluate_rows, in one batch for problems with
+ * Problem::evaluate_batch.
+ *
+ * Restarts, local search, checkpoints, self-adaptive rates and the adaptive
+ * crossover need the eoPop of GeneticAlgorithm and are not available here.
+ */
+class PackedGeneticAlgorithm {
+public:
+  typedef typename Chrom::Fitness Fitness;
+
+  PackedGeneticAlgorithm(
+      EvaluationCounter &evaluator_,
+      uint32_t tourRingSize_,
+      eoQuadOp<Chrom> &crossoverOp_,
+      const RateSchedule &crossoverRate_,
+      const RateSchedule &mutationRate_,
+      StopCriteria &continue_);
+
+  ~PackedGeneticAlgorithm() = default;
+
+  // Getter for the convergence vector (best fitness of each generation)
+  std::vector<Fitness> &get_convergence();
+
+  uint32_t get_generation() const;
+
+  // Getter for the time spent in each phase of the last execution
+  const PhaseTimer &get_phase_timer() const;
+
+  // Evolves the population until the stop criteria fires. Every individual
+  // of the population must have been evaluated (see
+  // EvaluationCounter::evaluate_all)
+  void operator()(PackedPopulation &population);
+
+protected:
+  EvaluationCounter &evaluator;
+  TournamentSelection selection;
+  eoQuadOp<Chrom> &cross;
+  PackedCrossover *packedCross;  // the crossover, if it works on the words
+  RateSchedule crossoverRate;
+  RateSchedule mutationRate;
+  StopCriteria &stopCriteria;
+  std::vector<Fitness> convergence;
+  PhaseTimer phaseTimer;
+  uint32_t generation = 0;
+
+  PackedPopulation nextGen;
+  PackedPopulation elite;
+  Chrom scratch1, scratch2;  // unpacked rows for the other crossovers
+  std::vector<size_t> parents;  // row of population copied to each row of nextGen
+  std::vector<size_t> pending;  // rows of nextGen to evaluate
+
+  // Crosses the rows i and j of nextGen; returns whether they changed
+  bool cross_rows(size_t i, size_t j);
+
+  // Flips each gene of row i of nextGen with probability `rate`; returns
+  // whether any gene changed
+  bool mutate_row(size_t i, double rate);
+};
+
+#endif //CROSSOVERRESEARCH_PACKED_GENETIC_ALGORITHM_H
@@ -0,0 +1,129 @@
+#include "packed_population.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+PackedPopulation::PackedPopulation(size_t numGenes_, size_t size)
+  : numGenes(numGenes_) {
+  // Linhas com um número inteiro de blocos de ALIGNMENT bytes
+  const size_t block = ALIGNMENT / sizeof(word_t);
+  this->words = std::max<size_t>(1, (packed::num_words(numGenes_) + block - 1) / block) * block;
+  this->resize(size);
+}
+
+void PackedPopulation::reserve(size_t size) {
+  if (size <= this->capacity) return;
+  const size_t bytes = size * this->words * sizeof(word_t);
+  word_t *grown = static_cast<word_t*>(std::aligned_alloc(ALIGNMENT, bytes));
+  if (!grown) throw std::bad_alloc();
+  if (this->count) {
+    std::memcpy(grown, this->bits.get(), this->count * this->words * sizeof(word_t));
+  }
+  this->bits.reset(grown);
+  this->capacity = size;
+  this->fitnessValues.reserve(size);
+  this->invalidFlags.reserve(size);
+}
+
+void PackedPopulation::resize(size_t size) {
+  if (size > this->capacity) {
+    // Crescimento geométrico para que append() seguidos não copiem a matriz
+    // a cada chamada
+    this->reserve(std::max(size, this->capacity + this->capacity / 2));
+  }
+  if (size > this->count) {
+    std::memset(this->row(this->count), 0,
+        (size - this->count) * this->words * sizeof(word_t));
+  }
+  this->fitnessValues.resize(size, Fitness());
+  this->invalidFlags.resize(size, 1);
+  this->count = size;
+}
+
+void PackedPopulation::copy_row(size_t to, const PackedPopulation &source,
+    size_t from) {
+  std::memcpy(this->row(to), source.row(from), this->words * sizeof(word_t));
+  this->fitnessValues[to] = source.fitnessValues[from];
+  this->invalidFlags[to] = source.invalidFlags[from];
+}
+
+void PackedPopulation::load(size_t i, const Chrom &chrom) {
+  if (chrom.size() != this->numGenes) {
+    throw std::runtime_error("PackedPopulation: cromossomo de tamanho diferente");
+  }
+  // As palavras de preenchimento já são zero e nunca são escritas
+  packed::pack(chrom, this->row(i));
+  if (chrom.invalid()) {
+    this->invalidate(i);
+  } else {
+    this->set_fitness(i, chrom.fitness());
+  }
+}
+
+void PackedPopulation::store(size_t i, Chrom &chrom) const {
+  chrom.resize(this->numGenes);
+  packed::unpack(this->row(i), chrom);
+  chrom.evalState.reset();
+  if (this->invalid(i)) {
+    chrom.invalidate();
+  } else {
+    chrom.fitness(this->fitnessValues[i]);
+  }
+}
+
+void PackedPopulation::append(const eoPop<Chrom> &pop) {
+  size_t i = this->count;
+  this->resize(this->count + pop.size());
+  for (const Chrom &chrom : pop) {
+    this->load(i++, chrom);
+  }
+}
+
+void PackedPopulation::remove_invalid() {
+  size_t kept = 0;
+  for (size_t i = 0; i < this->count; i++) {
+    if (this->invalid(i)) continue;
+    if (kept != i) this->copy_row(kept, *this, i);
+    kept++;
+  }
+  this->resize(kept);
+}
+
+size_t PackedPopulation::best() const {
+  size_t found = this->count;
+  for (size_t i = 0; i < this->count; i++) {
+    if (this->invalidFlags[i]) continue;
+    if (found == this->count or this->fitnessValues[i] > this->fitnessValues[found]) {
+      found = i;
+    }
+  }
+  return found;
+}
+
+size_t PackedPopulation::worst() const {
+  size_t found = this->count;
+  for (size_t i = 0; i < this->count; i++) {
+    if (this->invalidFlags[i]) continue;
+    if (found == this->count or this->fitnessValues[i] < this->fitnessValues[found]) {
+      found = i;
+    }
+  }
+  return found;
+}
+
+void PackedPopulation::swap(PackedPopulation &other) {
+  std::swap(this->numGenes, other.numGenes);
+  std::swap(this->words, other.words);
+  std::swap(this->count, other.count);
+  std::swap(this->capacity, other.capacity);
+  this->bits.swap(other.bits);
+  this->fitnessValues.swap(other.fitnessValues);
+  this->invalidFlags.swap(other.invalidFlags);
+}
+
+size_t PackedPopulation::memory_bytes() const {
+  return this->capacity * this->words * sizeof(word_t)
+      + this->fitnessValues.capacity() * sizeof(Fitness)
+      + this->invalidFlags.capacity() * sizeof(uint8_t);
+}
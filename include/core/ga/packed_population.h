@@ -0,0 +1,127 @@
+#ifndef CROSSOVERRESEARCH_PACKED_POPULATION_H
+#define CROSSOVERRESEARCH_PACKED_POPULATION_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include "encoding.h"
+#include "packed_bits.h"
+
+/**
+ * @class PackedPopulation
+ * População guardada como estrutura de arrays: uma única matriz de bits
+ * contígua (indivíduos x palavras, no formato de packed_bits.h) e, à parte, o
+ * fitness e a validade de cada indivíduo. Os indivíduos são identificados
+ * pelo índice da linha.
+ *
+ * Cada linha ocupa um número inteiro de linhas de cache (ALIGNMENT bytes) e a
+ * matriz é alinhada, então a memória usada é previsível (ver memory_bytes) e
+ * operações sobre várias linhas podem usar SIMD. As palavras de preenchimento
+ * no fim de cada linha e os bits que sobram na última palavra útil são sempre
+ * zero.
+ */
+class PackedPopulation {
+public:
+  using word_t = packed::word_t;
+  using Fitness = Chrom::Fitness;
+
+  static constexpr size_t ALIGNMENT = 64;  // bytes, uma linha de cache
+
+  explicit PackedPopulation(size_t numGenes = 0, size_t size = 0);
+
+  PackedPopulation(PackedPopulation &&) = default;
+  PackedPopulation &operator=(PackedPopulation &&) = default;
+
+  size_t size() const { return this->count; }
+  bool empty() const { return this->count == 0; }
+  size_t num_genes() const { return this->numGenes; }
+
+  // Palavras por linha, incluindo o preenchimento
+  size_t stride() const { return this->words; }
+
+  /**
+   * Altera o número de indivíduos. Os novos têm todos os genes zerados e
+   * fitness inválido */
+  void resize(size_t size);
+
+  /**
+   * Reserva espaço para `size` indivíduos sem alterar o tamanho */
+  void reserve(size_t size);
+
+  word_t *row(size_t i) { return this->bits.get() + i * this->words; }
+  const word_t *row(size_t i) const { return this->bits.get() + i * this->words; }
+
+  bool gene(size_t i, size_t g) const {
+    return (this->row(i)[g / packed::WORD_BITS] >> (g % packed::WORD_BITS)) & 1;
+  }
+
+  void flip(size_t i, size_t g) {
+    this->row(i)[g / packed::WORD_BITS] ^= word_t(1) << (g % packed::WORD_BITS);
+  }
+
+  Fitness fitness(size_t i) const { return this->fitnessValues[i]; }
+  bool invalid(size_t i) const { return this->invalidFlags[i] != 0; }
+
+  void set_fitness(size_t i, Fitness value) {
+    this->fitnessValues[i] = value;
+    this->invalidFlags[i] = 0;
+  }
+
+  void invalidate(size_t i) {
+    this->fitnessValues[i] = Fitness();
+    this->invalidFlags[i] = 1;
+  }
+
+  // Fitness de todos os indivíduos em sequência (inválidos valem Fitness())
+  const Fitness *fitness_data() const { return this->fitnessValues.data(); }
+
+  /**
+   * Copia genes e fitness da linha `from` de `source` (que deve ter o mesmo
+   * número de genes) para a linha `to` */
+  void copy_row(size_t to, const PackedPopulation &source, size_t from);
+
+  /**
+   * Escreve um cromossomo (do tamanho num_genes) na linha `i`, com o fitness
+   * dele */
+  void load(size_t i, const Chrom &chrom);
+
+  /**
+   * Copia a linha `i` para um cromossomo, redimensionado se preciso */
+  void store(size_t i, Chrom &chrom) const;
+
+  /**
+   * Acrescenta os indivíduos de uma população ao fim */
+  void append(const eoPop<Chrom> &pop);
+
+  /**
+   * Remove os indivíduos inválidos, mantendo a ordem dos demais */
+  void remove_invalid();
+
+  /**
+   * Índice do indivíduo válido de maior fitness (ou do pior), ou size() se
+   * não houver nenhum válido */
+  size_t best() const;
+  size_t worst() const;
+
+  void swap(PackedPopulation &other);
+
+  /**
+   * Memória reservada para a matriz de bits e os vetores de fitness */
+  size_t memory_bytes() const;
+
+private:
+  struct FreeDeleter {
+    void operator()(word_t *p) const { std::free(p); }
+  };
+
+  size_t numGenes;
+  size_t words;           // palavras por linha (múltiplo de ALIGNMENT)
+  size_t count = 0;
+  size_t capacity = 0;
+  std::unique_ptr<word_t[], FreeDeleter> bits;
+  std::vector<Fitness> fitnessValues;
+  std::vector<uint8_t> invalidFlags;
+};
+
+#endif //CROSSOVERRESEARCH_PACKED_POPULATION_H
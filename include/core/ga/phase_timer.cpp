@@ -0,0 +1,34 @@
+#include "phase_timer.h"
+#include <sstream>
+
+void PhaseTimer::reset() {
+  this->elapsed.fill(clock::duration::zero());
+  this->mark = clock::now();
+}
+
+double PhaseTimer::milliseconds(phase p) const {
+  using ms = std::chrono::duration<double, std::milli>;
+  return std::chrono::duration_cast<ms>(this->elapsed[p]).count();
+}
+
+const char *PhaseTimer::name(phase p) {
+  switch (p) {
+    case selection:    return "selection";
+    case crossover:    return "crossover";
+    case mutation:     return "mutation";
+    case repair:       return "repair";
+    case evaluation:   return "evaluation";
+    case local_search: return "local_search";
+    case elitism:      return "elitism";
+    default:           return "unknown";
+  }
+}
+
+std::string PhaseTimer::to_string() const {
+  std::stringstream ss;
+  for (int p = 0; p < num_phases; p++) {
+    if (p > 0) ss << ',';
+    ss << name(phase(p)) << ':' << milliseconds(phase(p));
+  }
+  return ss.str();
+}
@@ -0,0 +1,67 @@
+#ifndef CROSSOVERRESEARCH_PHASE_TIMER_H
+#define CROSSOVERRESEARCH_PHASE_TIMER_H
+
+#include <array>
+#include <chrono>
+#include <string>
+
+/**
+ * @class PhaseTimer
+ * Acumula o tempo gasto em cada fase do laço principal do AG. Cada chamada a
+ * lap() custa uma leitura do steady_clock, então o custo por geração é fixo e
+ * independente do tamanho da população.
+ */
+class PhaseTimer {
+public:
+  using clock = std::chrono::steady_clock;
+
+  enum phase {
+    selection,
+    crossover,
+    mutation,
+    repair,
+    evaluation,
+    local_search,
+    elitism,
+    num_phases
+  };
+
+  PhaseTimer() { this->reset(); }
+
+  /**
+   * Zera todos os acumuladores */
+  void reset();
+
+  /**
+   * Marca o início de uma sequência de fases */
+  void start() {
+    this->mark = clock::now();
+  }
+
+  /**
+   * Soma à fase `p` o tempo decorrido desde a última marcação e faz uma
+   * nova marcação */
+  void lap(phase p) {
+    clock::time_point now = clock::now();
+    this->elapsed[p] += now - this->mark;
+    this->mark = now;
+  }
+
+  /**
+   * Tempo total acumulado em uma fase, em milisegundos */
+  double milliseconds(phase p) const;
+
+  /**
+   * Nome de uma fase (usado na saída e no banco de dados) */
+  static const char *name(phase p);
+
+  /**
+   * Texto com os tempos de todas as fases: "selection:1.5,crossover:0.3,..." */
+  std::string to_string() const;
+
+private:
+  clock::time_point mark;
+  std::array<clock::duration, num_phases> elapsed;
+};
+
+#endif //CROSSOVERRESEARCH_PHASE_TIMER_H
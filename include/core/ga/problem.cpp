@@ -1,10 +1,12 @@
 #include "problem.h"
+#include <stdexcept>
 
 size_t Problem::get_chromsize() {
     return this->chromSize;
 }
 
 void Problem::eval(Chrom& chromosome) {
+  this->repair(chromosome);
   this->operator()(chromosome);
 }
 
@@ -21,6 +23,24 @@ void Problem::eval(eoPop<Chrom>& pop) {
 #endif
 }
 
+std::vector<std::string> Problem::take_reports() {
+    std::vector<std::string> taken;
+    taken.swap(this->reports);
+    return taken;
+}
+
 bool Problem::is_minimization() {
     return this->minimization;
 }
+
+void Problem::preprocess(const std::string &spec) {
+    if (!spec.empty()) {
+        throw std::invalid_argument("Este problema não tem pré-processamento");
+    }
+}
+
+void Problem::set_decoder(const std::string &name) {
+    if (!name.empty()) {
+        throw std::invalid_argument("Este problema não tem decodificador " + name);
+    }
+}
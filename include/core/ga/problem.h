@@ -2,9 +2,15 @@
 #define CROSSOVERRESEARCH_PROBLEM_H
 
 #include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
 #include <paradiseo/eo/eoEvalFunc.h>
 #include "encoding.h"
 
+class LocalSearch;
+class PackedPopulation;
+
 /**
  * classe Problem
  * 
@@ -31,8 +37,9 @@ public:
 
   /*
 	 * Evaluator of chromosomes.
-	 * This method apply the objective function with a chromosome computing
-	 * the fitness and set the resultant fitness value to the chromosome. */
+	 * This method repairs the chromosome and then apply the objective function
+	 * computing the fitness and set the resultant fitness value to the
+	 * chromosome. */
 	void eval(Chrom &chromosome);
 
 	/**
@@ -43,6 +50,81 @@ public:
    * Definition of the objective function */
   void operator()(Chrom& chromosome) = 0;
 
+  /**
+   * Repair (feasibility) operator applied before the objective function.
+   * Problems that only penalize infeasible solutions keep this default,
+   * which does nothing. */
+  virtual void repair(Chrom& chromosome) {}
+
+  /**
+   * Whether repair() can change a chromosome. Problems without a repair may
+   * return false so that the packed evaluation skips unpacking the rows. */
+  virtual bool has_repair() const { return true; }
+
+  /**
+   * Whether evaluate_batch is implemented. */
+  virtual bool has_batch_evaluation() const { return false; }
+
+  /**
+   * Computes the fitness of the (already repaired) rows `rows` of `pop`:
+   * fitness[r] receives the fitness of row rows[r]. Must give the same
+   * fitness operator() gives to the unpacked row. Only called when
+   * has_batch_evaluation() returns true. */
+  virtual void evaluate_batch(const PackedPopulation &pop,
+      const std::vector<size_t> &rows, std::vector<Fitness> &fitness) {}
+
+  /**
+   * Registers crossover operators specific to this problem in the
+   * CrossoverFabric, so they can be chosen by name like the generic ones.
+   * Must be called before the operator is created. */
+  virtual void register_crossovers() {}
+
+  /**
+   * Optional instance preprocessing (reductions, reordering of the genes),
+   * described by `spec` in the "key=value,..." format. Must be called
+   * before the population is created, since the chromosome size can change.
+   * Problems without preprocessing reject any spec. */
+  virtual void preprocess(const std::string &spec);
+
+  /**
+   * Chooses how chromosomes are decoded into solutions when the problem has
+   * more than one decoder. Called after preprocess. Problems with a single
+   * decoder reject any name other than the empty string. */
+  virtual void set_decoder(const std::string &name);
+
+  /**
+   * Index in the original instance of the element represented by a gene.
+   * Differs from the gene only after a preprocessing that removes or
+   * reorders elements. */
+  virtual size_t original_index(size_t gene) const { return gene; }
+
+  /**
+   * Creates the local search used by the memetic step of the GA, or returns
+   * nullptr if this problem has none. The caller owns the object. */
+  virtual LocalSearch *create_local_search() { return nullptr; }
+
+  /**
+   * Creates a copy of this problem that can repair and evaluate chromosomes
+   * in another thread, concurrently with this one and with other copies
+   * (read-only data of the instance may be shared), or returns nullptr if
+   * the problem has none. Used by the asynchronous GA, one copy per worker.
+   * The caller owns the object. */
+  virtual Problem *clone_evaluator() const { return nullptr; }
+
+  /**
+   * Optimal cost of this instance when it is known (in the same unit as the
+   * reported solution cost), or NaN otherwise. Used by target=opt in the
+   * stop criteria. */
+  virtual double known_optimum() {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+
+  /**
+   * Reports of the instance loading, preprocessing and decoder setup
+   * (sizes, timings) produced since the last call. The runner prints them
+   * in verbose mode. */
+  std::vector<std::string> take_reports();
+
 	/**
 	 * Population initializer
 	 * Initialize a population with Encoding and chromSize defined in
@@ -53,6 +135,7 @@ protected:
 	size_t chromSize; // size of the chromosomes in this problem instance
   std::string instanceFilename; // name of input file of this instance
 	bool minimization;
+  std::vector<std::string> reports; // see take_reports
   // eoEvalFunc<Chrom> *evalFunction; // Ponteiro para um objeto de função obj.
 };
 
@@ -0,0 +1,172 @@
+#include "rate_control.h"
+#include "crossover_fabric.h"
+#include "entropy.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <paradiseo/eo/utils/eoRNG.h>
+
+double RateSchedule::parse_value(const std::string &text, size_t chromsize) {
+  const size_t slash = text.find('/');
+  try {
+    size_t pos = 0;
+    if (slash != std::string::npos && text.substr(slash + 1) == "L") {
+      const double k = std::stod(text.substr(0, slash), &pos);
+      if (pos == slash) return k / chromsize;
+    } else {
+      const double value = std::stod(text, &pos);
+      if (pos == text.size()) return value;
+    }
+  } catch (std::exception &e) {
+  }
+  throw std::invalid_argument("Taxa inválida: '" + text + "'");
+}
+
+RateSchedule RateSchedule::parse(const std::string &text, size_t chromsize) {
+  RateSchedule schedule;
+  schedule.text = text;
+
+  if (text.find(':') == std::string::npos && text.find('=') == std::string::npos
+      && text != "linear" && text != "exp" && text != "diversity") {
+    schedule.kind = constant;
+    schedule.from = parse_value(text, chromsize);
+    return schedule;
+  }
+
+  const CrossoverSpec spec = CrossoverSpec::parse(text);
+  auto param = [&](const std::string &key, const std::string &defaultValue) {
+    auto it = spec.params.find(key);
+    return parse_value(it != spec.params.end() ? it->second : defaultValue,
+        chromsize);
+  };
+
+  if (spec.name == "linear") {
+    spec.check_params({"from", "to", "gens"});
+    schedule.kind = linear;
+    schedule.from = param("from", "0.1");
+    schedule.to = param("to", "1/L");
+    schedule.generations = std::max(1.0, param("gens", "500"));
+  } else if (spec.name == "exp") {
+    spec.check_params({"from", "decay", "min"});
+    schedule.kind = exponential;
+    schedule.from = param("from", "0.1");
+    schedule.decay = param("decay", "0.99");
+    schedule.to = param("min", "1/L");
+  } else if (spec.name == "diversity") {
+    spec.check_params({"low", "high", "threshold"});
+    schedule.kind = diversity;
+    schedule.from = param("low", "1/L");
+    schedule.to = param("high", "0.05");
+    schedule.threshold = param("threshold", "0.3");
+  } else {
+    throw std::invalid_argument("Cronograma de taxa desconhecido: " + spec.name
+        + ". Disponíveis: linear exp diversity");
+  }
+  return schedule;
+}
+
+double RateSchedule::value(uint32_t generation, double entropy) const {
+  switch (this->kind) {
+    case linear: {
+      const double t = std::min(1.0, generation / this->generations);
+      return this->from + t * (this->to - this->from);
+    }
+    case exponential:
+      return std::max(this->to, this->from * std::pow(this->decay, generation));
+    case diversity:
+      return entropy < this->threshold ? this->to : this->from;
+    case constant:
+    default:
+      return this->from;
+  }
+}
+
+bool BitFlipMutation::operator()(Chrom &chrom) {
+  if (this->rate <= 0.0 || chrom.empty()) return false;
+
+  const size_t n = chrom.size();
+  if (this->rate >= 1.0) {
+    chrom.flip();
+    return true;
+  }
+
+  // Distância até o próximo bit invertido: geométrica com parâmetro rate
+  const double logq = std::log1p(-this->rate);
+  bool changed = false;
+  double pos = std::floor(std::log1p(-rng.uniform()) / logq);
+  while (pos < n) {
+    const size_t i = static_cast<size_t>(pos);
+    chrom[i] = !chrom[i];
+    changed = true;
+    pos += 1.0 + std::floor(std::log1p(-rng.uniform()) / logq);
+  }
+  return changed;
+}
+
+RateControl::RateControl(const RateSchedule &crossover,
+    const RateSchedule &mutation, bool selfAdaptive, size_t chromsize)
+  : crossoverSchedule(crossover), mutationSchedule(mutation),
+    selfAdaptive(selfAdaptive), minMutation(0.1 / chromsize) {}
+
+void RateControl::update(uint32_t generation, eoPop<Chrom> &population) {
+  double entropy = 1.0;
+  if (this->crossoverSchedule.needs_entropy()
+      || this->mutationSchedule.needs_entropy()) {
+    entropy = Entropy::overall(population);
+  }
+  this->crossover = this->crossoverSchedule.value(generation, entropy);
+  this->mutation = this->mutationSchedule.value(generation, entropy);
+
+  // No modo auto-adaptativo os cronogramas só dão as taxas iniciais de quem
+  // ainda não tem as suas; as taxas registradas são as médias da população
+  if (this->selfAdaptive && !population.empty()) {
+    double sumCrossover = 0.0, sumMutation = 0.0;
+    for (Chrom &chrom : population) {
+      if (chrom.crossoverRate < 0) chrom.crossoverRate = this->crossover;
+      if (chrom.mutationRate < 0) chrom.mutationRate = this->mutation;
+      sumCrossover += chrom.crossoverRate;
+      sumMutation += chrom.mutationRate;
+    }
+    this->crossover = sumCrossover / population.size();
+    this->mutation = sumMutation / population.size();
+  }
+  this->history.emplace_back(this->crossover, this->mutation);
+}
+
+double RateControl::crossover_rate(const Chrom &a, const Chrom &b) const {
+  if (this->selfAdaptive && a.crossoverRate >= 0 && b.crossoverRate >= 0) {
+    return (a.crossoverRate + b.crossoverRate) / 2;
+  }
+  return this->crossover;
+}
+
+double RateControl::perturb(double rate) {
+  rate = std::min(std::max(rate, 1e-9), 1.0 - 1e-9);
+  return 1.0 / (1.0 + (1.0 - rate) / rate
+      * std::exp(-LEARNING_RATE * rng.normal()));
+}
+
+bool RateControl::mutate(Chrom &chrom) {
+  if (this->selfAdaptive) {
+    if (chrom.crossoverRate < 0) chrom.crossoverRate = this->crossover;
+    if (chrom.mutationRate < 0) chrom.mutationRate = this->mutation;
+    chrom.crossoverRate = perturb(chrom.crossoverRate);
+    chrom.mutationRate = std::max(this->minMutation, perturb(chrom.mutationRate));
+    this->flip.set_rate(chrom.mutationRate);
+  } else {
+    this->flip.set_rate(this->mutation);
+  }
+  return this->flip(chrom);
+}
+
+std::string RateControl::log_to_string() const {
+  std::stringstream ss;
+  ss << this->crossoverSchedule.description() << '|'
+     << this->mutationSchedule.description();
+  if (this->selfAdaptive) ss << "|self-adaptive";
+  for (const auto &rates : this->history) {
+    ss << ';' << rates.first << '/' << rates.second;
+  }
+  return ss.str();
+}
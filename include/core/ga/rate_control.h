@@ -0,0 +1,121 @@
+#ifndef CROSSOVERRESEARCH_RATE_CONTROL_H
+#define CROSSOVERRESEARCH_RATE_CONTROL_H
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <paradiseo/eo/eoOp.h>
+#include "encoding.h"
+
+/**
+ * @class RateSchedule
+ * Valor de uma taxa ao longo das gerações, descrito no mesmo formato dos
+ * operadores de crossover ("nome:chave=valor,..."). Valores podem ser números
+ * ou frações do tamanho L do cromossomo ("1/L", "2/L"):
+ *
+ *   0.05 ou 1/L                              constante
+ *   linear:from=0.1,to=1/L,gens=500          interpola até a geração gens
+ *   exp:from=0.1,decay=0.99,min=1/L          from * decay^g, limitado a min
+ *   diversity:low=1/L,high=0.05,threshold=0.3
+ *       high enquanto a entropia média dos genes da população (de 0 a 1)
+ *       estiver abaixo de threshold e low caso contrário
+ */
+class RateSchedule {
+public:
+  static RateSchedule parse(const std::string &text, size_t chromsize);
+
+  /**
+   * Converte um valor ("0.05", "1/L", "3/L") */
+  static double parse_value(const std::string &text, size_t chromsize);
+
+  double value(uint32_t generation, double entropy) const;
+
+  bool needs_entropy() const { return this->kind == diversity; }
+
+  const std::string &description() const { return this->text; }
+
+private:
+  enum Kind { constant, linear, exponential, diversity };
+
+  Kind kind = constant;
+  double from = 0.0, to = 0.0, generations = 1.0, decay = 1.0;
+  double threshold = 0.0;
+  std::string text;
+};
+
+/**
+ * @class BitFlipMutation
+ * Mutação bit a bit com taxa ajustável. As posições invertidas são sorteadas
+ * pela distância geométrica até a próxima inversão, então o custo é
+ * proporcional ao número de bits invertidos e não ao tamanho do cromossomo.
+ */
+class BitFlipMutation : public eoMonOp<Chrom> {
+public:
+  explicit BitFlipMutation(double rate = 0.0) : rate(rate) {}
+
+  bool operator()(Chrom &chrom) override;
+
+  void set_rate(double rate_) { this->rate = rate_; }
+
+  std::string className() const { return "BitFlipMutation"; }
+
+private:
+  double rate;
+};
+
+/**
+ * @class RateControl
+ * Taxas de cruzamento e mutação (por bit) controladas durante a execução do
+ * GeneticAlgorithm, por cronograma (RateSchedule) ou auto-adaptativas.
+ *
+ * No modo auto-adaptativo cada indivíduo carrega suas próprias taxas
+ * (Chrom::crossoverRate e Chrom::mutationRate), iniciadas pelo cronograma.
+ * Um par cruza com a média das taxas dos pais, e antes da mutação as taxas
+ * de cada filho sofrem uma perturbação log-normal na escala logística
+ * p' = 1 / (1 + (1 - p) / p * exp(-gamma * N(0, 1))), que as mantém em (0, 1).
+ * A mutação dos genes usa então a taxa já perturbada, então as taxas que
+ * produzem filhos melhores sobrevivem com eles.
+ */
+class RateControl {
+public:
+  RateControl(const RateSchedule &crossover, const RateSchedule &mutation,
+      bool selfAdaptive, size_t chromsize);
+
+  /**
+   * Atualiza as taxas no início de uma geração */
+  void update(uint32_t generation, eoPop<Chrom> &population);
+
+  /**
+   * Probabilidade de cruzamento do par (a, b) */
+  double crossover_rate(const Chrom &a, const Chrom &b) const;
+
+  /**
+   * Muta os genes com a taxa corrente (ou a do indivíduo, depois de
+   * perturbá-la). Retorna true se algum gene mudou */
+  bool mutate(Chrom &chrom);
+
+  // Taxas da geração corrente (médias da população no modo auto-adaptativo)
+  double current_crossover() const { return this->crossover; }
+  double current_mutation() const { return this->mutation; }
+
+  bool is_self_adaptive() const { return this->selfAdaptive; }
+
+  /**
+   * Histórico: "cronograma de cruzamento|cronograma de mutação;c/m;c/m;..."
+   * com as taxas de cada geração */
+  std::string log_to_string() const;
+
+private:
+  RateSchedule crossoverSchedule, mutationSchedule;
+  bool selfAdaptive;
+  double minMutation;   // limite inferior da taxa de mutação própria
+  double crossover = 0.0, mutation = 0.0;
+  BitFlipMutation flip;
+  std::vector<std::pair<double, double>> history;
+
+  static constexpr double LEARNING_RATE = 0.22;
+
+  static double perturb(double rate);
+};
+
+#endif //CROSSOVERRESEARCH_RATE_CONTROL_H
@@ -0,0 +1,66 @@
+#include "restart_policy.h"
+#include "crossover_fabric.h"
+#include "entropy.h"
+#include <algorithm>
+#include <stdexcept>
+
+RestartPolicy::RestartPolicy(uint32_t stagnation, double entropy,
+    uint32_t keep, double bias)
+  : stagnation(stagnation), entropy(entropy), keep(std::max(1u, keep)),
+    bias(bias) {}
+
+RestartPolicy RestartPolicy::parse(const std::string &text) {
+  // Mesmo formato de parâmetros dos operadores de crossover
+  const CrossoverSpec spec = CrossoverSpec::parse("restart:" + text);
+  spec.check_params({"gens", "entropy", "keep", "bias"});
+  const double gens = spec.get("gens", 0), keep = spec.get("keep", 1);
+  if (gens < 0 or keep < 1) {
+    throw std::invalid_argument("restart: gens deve ser >= 0 e keep >= 1");
+  }
+  return RestartPolicy(uint32_t(gens), spec.get("entropy", 0.0), uint32_t(keep),
+      spec.get("bias", 0.25));
+}
+
+bool RestartPolicy::operator()(uint32_t generation, eoPop<Chrom> &population,
+    EvaluationCounter &evaluator) {
+  if (population.empty()) return false;
+
+  const Fitness current = population.best_element().fitness();
+  if (!this->started or current > this->best) {
+    this->started = true;
+    this->best = current;
+    this->lastImprovement = generation;
+  }
+
+  bool trigger = this->stagnation > 0
+      and generation - this->lastImprovement >= this->stagnation;
+  if (!trigger and this->entropy > 0) {
+    trigger = Entropy::overall(population) < this->entropy;
+  }
+  if (!trigger or evaluator.exhausted()) return false;
+
+  this->restart(population, evaluator);
+  this->restartGenerations.push_back(generation);
+  this->lastImprovement = generation;
+  return true;
+}
+
+void RestartPolicy::restart(eoPop<Chrom> &population,
+    EvaluationCounter &evaluator) {
+  const size_t popsize = population.size();
+  const size_t kept = std::min<size_t>(this->keep, popsize);
+
+  // Ordena do melhor para o pior e substitui a partir do fim, preservando
+  // os `kept` primeiros
+  std::sort(population.begin(), population.end(),
+      [](const Chrom &a, const Chrom &b) { return a.fitness() > b.fitness(); });
+
+  eoPop<Chrom> fresh = evaluator.get_problem().init_pop(popsize - kept, this->bias);
+  for (size_t i = popsize; i > kept; i--) {
+    Chrom &individual = fresh[i - kept - 1];
+    evaluator.repair(individual);
+    evaluator.evaluate(individual);
+    if (individual.invalid()) break;  // orçamento esgotado
+    population[i - 1].swap(individual);
+  }
+}
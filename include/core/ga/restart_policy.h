@@ -0,0 +1,65 @@
+#ifndef CROSSOVERRESEARCH_RESTART_POLICY_H
+#define CROSSOVERRESEARCH_RESTART_POLICY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "encoding.h"
+#include "evaluation_counter.h"
+
+/**
+ * @class RestartPolicy
+ * Reinício parcial da população quando a busca estagna. Ao fim de uma
+ * geração, se o melhor fitness não melhora há `stagnation` gerações ou se a
+ * entropia média dos genes cai abaixo de `entropy`, os `keep` melhores
+ * indivíduos são mantidos e o restante é gerado de novo por
+ * Problem::init_pop. Os novos indivíduos são reparados e avaliados pelo
+ * EvaluationCounter, então consomem o orçamento de avaliações como qualquer
+ * filho. A substituição começa pelos piores, então se o orçamento acabar no
+ * meio do reinício os melhores indivíduos antigos continuam na população.
+ */
+class RestartPolicy {
+public:
+  using Fitness = Chrom::Fitness;
+
+  /**
+   * @param stagnation gerações sem melhora para reiniciar (0 desativa)
+   * @param entropy entropia média mínima, entre 0 e 1 (0 desativa)
+   * @param keep número de melhores indivíduos mantidos (ao menos 1)
+   * @param bias viés dos alelos "1" passado a Problem::init_pop
+   */
+  RestartPolicy(uint32_t stagnation, double entropy = 0.0, uint32_t keep = 1,
+      double bias = 0.25);
+
+  /**
+   * Descrição no formato "gens=50,entropy=0.1,keep=5" (chaves opcionais) */
+  static RestartPolicy parse(const std::string &text);
+
+  /**
+   * Verifica os gatilhos ao fim de uma geração e, se algum disparar,
+   * reinicia a população. Retorna true se houve reinício */
+  bool operator()(uint32_t generation, eoPop<Chrom> &population,
+      EvaluationCounter &evaluator);
+
+  uint32_t restarts() const { return this->restartGenerations.size(); }
+
+  // Gerações em que houve reinício
+  const std::vector<uint32_t> &generations() const {
+    return this->restartGenerations;
+  }
+
+private:
+  uint32_t stagnation;
+  double entropy;
+  uint32_t keep;
+  double bias;
+
+  bool started = false;
+  Fitness best = Fitness();
+  uint32_t lastImprovement = 0;
+  std::vector<uint32_t> restartGenerations;
+
+  void restart(eoPop<Chrom> &population, EvaluationCounter &evaluator);
+};
+
+#endif //CROSSOVERRESEARCH_RESTART_POLICY_H
@@ -0,0 +1,132 @@
+#include "stop_criteria.h"
+#include "crossover_fabric.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+// Se o fitness `best` atinge o alvo de `limits`, com a tolerância gap
+bool reaches(const StopLimits &limits, bool minimization, Chrom::Fitness best) {
+  const double tolerance = limits.gap * std::fabs(limits.target);
+  if (minimization) {
+    return 1.0 / double(best) <= limits.target + tolerance;
+  }
+  return double(best) >= limits.target - tolerance;
+}
+
+} // namespace
+
+StopLimits StopLimits::parse(const std::string &text) {
+  StopLimits limits;
+  if (!text.empty() && std::all_of(text.begin(), text.end(), ::isdigit)) {
+    limits.evaluations = std::stoul(text);
+    return limits;
+  }
+
+  // Mesmo formato de parâmetros dos operadores de crossover
+  const CrossoverSpec spec = CrossoverSpec::parse("stop:" + text);
+  spec.check_params({"evals", "gens", "time", "target", "gap"});
+  const double evals = spec.get("evals", 0), gens = spec.get("gens", 0);
+  limits.seconds = spec.get("time", 0);
+  limits.gap = spec.get("gap", 0);
+  if (evals < 0 or gens < 0 or limits.seconds < 0 or limits.gap < 0) {
+    throw std::invalid_argument("stop: os limites não podem ser negativos");
+  }
+  limits.evaluations = (unsigned long) evals;
+  limits.generations = (uint32_t) gens;
+
+  auto it = spec.params.find("target");
+  if (it != spec.params.end()) {
+    limits.hasTarget = true;
+    limits.targetOptimum = it->second == "opt";
+    if (!limits.targetOptimum) limits.target = spec.get("target", 0);
+  }
+  if (!limits.evaluations and !limits.generations and limits.seconds <= 0
+      and !limits.hasTarget) {
+    throw std::invalid_argument("stop: nenhum critério de parada informado");
+  }
+  return limits;
+}
+
+std::string StopLimits::to_string() const {
+  std::stringstream ss;
+  const char *sep = "";
+  if (this->evaluations) { ss << sep << "evals=" << this->evaluations; sep = ","; }
+  if (this->generations) { ss << sep << "gens=" << this->generations; sep = ","; }
+  if (this->seconds > 0) { ss << sep << "time=" << this->seconds; sep = ","; }
+  if (this->hasTarget) {
+    ss << sep << "target=";
+    if (this->targetOptimum) ss << "opt"; else ss << this->target;
+    if (this->gap > 0) ss << ",gap=" << this->gap;
+  }
+  return ss.str();
+}
+
+StopCriteria::StopCriteria(const StopLimits &limits_, EvaluationCounter &counter_,
+    bool minimization_, uint32_t doneGenerations, double doneSeconds_)
+  : limits(limits_), counter(counter_), minimization(minimization_),
+    generations(doneGenerations), doneSeconds(doneSeconds_),
+    start(std::chrono::steady_clock::now()) {
+  if (this->limits.hasTarget and this->limits.targetOptimum) {
+    throw std::invalid_argument("stop: o alvo \"opt\" não foi resolvido");
+  }
+  this->counter.set_budget(this->limits.evaluations);
+  // O contador registra a avaliação que atinge o alvo assim que ela é feita;
+  // o critério só é consultado ao fim de cada geração
+  std::function<bool(Chrom::Fitness)> reached;
+  if (this->limits.hasTarget) {
+    reached = [limits = this->limits, minimization = this->minimization](
+        Chrom::Fitness best) { return reaches(limits, minimization, best); };
+  }
+  this->counter.watch_target(std::move(reached));
+}
+
+double StopCriteria::elapsed() const {
+  std::chrono::duration<double> run = std::chrono::steady_clock::now() - this->start;
+  return this->doneSeconds + run.count();
+}
+
+bool StopCriteria::reached(Chrom::Fitness best) const {
+  return reaches(this->limits, this->minimization, best);
+}
+
+bool StopCriteria::operator()(const eoPop<Chrom> &population) {
+  // O melhor indivíduo só importa quando há um alvo
+  if (!this->limits.hasTarget or population.empty()) return this->check(nullptr);
+  const Chrom::Fitness best = population.best_element().fitness();
+  return this->check(&best);
+}
+
+bool StopCriteria::operator()(Chrom::Fitness best) {
+  return this->check(&best);
+}
+
+bool StopCriteria::check(const Chrom::Fitness *best) {
+  this->generations++;
+
+  if (this->limits.hasTarget and best and this->reached(*best)) {
+    if (this->targetSeconds < 0 and this->counter.target_hit()) {
+      std::chrono::duration<double> run = this->counter.target_time() - this->start;
+      this->targetSeconds = this->doneSeconds + run.count();
+      this->targetEvaluations = long(this->counter.target_evaluations());
+    } else if (this->targetSeconds < 0) {
+      // Atingido por um indivíduo avaliado antes deste critério existir (a
+      // população inicial)
+      this->targetSeconds = this->elapsed();
+      this->targetEvaluations = long(this->counter.objective_calls());
+    }
+    this->firedBy = "target";
+  } else if (this->counter.exhausted()) {
+    this->firedBy = "evaluations";
+  } else if (this->limits.generations
+      and this->generations >= this->limits.generations) {
+    this->firedBy = "generations";
+  } else if (this->limits.seconds > 0 and this->elapsed() >= this->limits.seconds) {
+    this->firedBy = "time";
+  }
+  return this->firedBy.empty();
+}
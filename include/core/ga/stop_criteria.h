@@ -0,0 +1,112 @@
+#ifndef CROSSOVERRESEARCH_STOP_CRITERIA_H
+#define CROSSOVERRESEARCH_STOP_CRITERIA_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <paradiseo/eo/eoContinue.h>
+#include "encoding.h"
+#include "evaluation_counter.h"
+
+/**
+ * @struct StopLimits
+ * Limites de uma execução do AG, descritos no formato
+ * "evals=100000,gens=500,time=60,target=3800,gap=0.01". Todas as chaves são
+ * opcionais e um limite ausente (ou zero) não é usado:
+ *
+ *   evals   chamadas à função objetivo
+ *   gens    gerações
+ *   time    tempo de evolução em segundos
+ *   target  custo alvo na unidade do problema, ou "opt" para o ótimo
+ *           conhecido da instância (Problem::known_optimum)
+ *   gap     tolerância relativa ao alvo [default = 0]
+ *
+ * Um número sozinho é o formato antigo e limita as avaliações.
+ */
+struct StopLimits {
+  unsigned long evaluations = 0;
+  uint32_t generations = 0;
+  double seconds = 0.0;
+  bool hasTarget = false;
+  bool targetOptimum = false;  // alvo ainda a resolver com o ótimo conhecido
+  double target = 0.0;
+  double gap = 0.0;
+
+  static StopLimits parse(const std::string &text);
+
+  /**
+   * Forma canônica, com os limites em uso na ordem acima */
+  std::string to_string() const;
+};
+
+/**
+ * @class StopCriteria
+ * Critério de parada composto: a evolução termina assim que qualquer um dos
+ * limites de StopLimits é atingido, e o critério que disparou fica
+ * registrado. O limite de avaliações vira o orçamento do EvaluationCounter,
+ * então é respeitado exatamente mesmo no meio de uma geração; os demais são
+ * verificados ao fim de cada geração.
+ *
+ * Quando há um alvo, também registra o tempo e o número de avaliações até o
+ * melhor indivíduo atingi-lo (time-to-target). Eles são os da avaliação que
+ * atingiu o alvo, registrada pelo EvaluationCounter, e não os do fim da
+ * geração em que o critério percebe o alvo.
+ */
+class StopCriteria : public eoContinue<Chrom> {
+public:
+  /**
+   * @param limits limites da execução (um alvo "opt" já deve estar resolvido)
+   * @param counter contador de avaliações do AG
+   * @param minimization se o fitness é o inverso do custo
+   * @param doneGenerations gerações já feitas (execução retomada)
+   * @param doneSeconds tempo de evolução já decorrido (execução retomada)
+   */
+  StopCriteria(const StopLimits &limits, EvaluationCounter &counter,
+      bool minimization, uint32_t doneGenerations = 0, double doneSeconds = 0.0);
+
+  bool operator()(const eoPop<Chrom> &population) override;
+
+  /**
+   * O mesmo critério a partir do melhor fitness da geração, para populações
+   * que não são um eoPop (ver PackedPopulation) */
+  bool operator()(Chrom::Fitness best);
+
+  /**
+   * Critério que encerrou a execução ("evaluations", "generations", "time"
+   * ou "target"), ou vazio se nenhum disparou */
+  const std::string &fired() const { return this->firedBy; }
+
+  bool target_reached() const { return this->targetSeconds >= 0; }
+
+  // Tempo (s) e avaliações até atingir o alvo, ou -1 se não atingido
+  double time_to_target() const { return this->targetSeconds; }
+  long evaluations_to_target() const { return this->targetEvaluations; }
+
+  /**
+   * Tempo de evolução em segundos, incluindo o de uma execução retomada */
+  double elapsed() const;
+
+  const StopLimits &get_limits() const { return this->limits; }
+
+  std::string className() const override { return "StopCriteria"; }
+
+private:
+  StopLimits limits;
+  EvaluationCounter &counter;
+  bool minimization;
+  uint32_t generations;
+  double doneSeconds;
+  std::chrono::steady_clock::time_point start;
+  std::string firedBy;
+  double targetSeconds = -1.0;
+  long targetEvaluations = -1;
+
+  // Conta uma geração e verifica os limites; `best` (o melhor fitness) pode
+  // ser nulo quando não há alvo ou a população está vazia
+  bool check(const Chrom::Fitness *best);
+
+  // Verifica se o melhor fitness atinge o alvo, com a tolerância gap
+  bool reached(Chrom::Fitness best) const;
+};
+
+#endif //CROSSOVERRESEARCH_STOP_CRITERIA_H
@@ -0,0 +1,209 @@
+#include "tournament_selection.h"
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <paradiseo/eo/utils/eoRNG.h>
+#include <core/utils/simd_dispatch.h>
+
+namespace {
+
+static_assert(std::is_same<TournamentSelection::Fitness, double>::value,
+    "os kernels comparam o fitness como double");
+
+constexpr size_t LANES = 8;  // torneios por bloco, um gerador por lane
+
+/**
+ * Um kernel faz `blocks` blocos de LANES torneios de `ring` competidores
+ * sorteados entre os `popsize` primeiros de `fitness`, avançando os geradores
+ * `state` (um por lane), e escreve o vencedor do torneio i em winners[i] */
+struct Kernel {
+  const char *name;
+  void (*run)(const double *fitness, uint64_t popsize, unsigned ring,
+      uint64_t *state, size_t blocks, uint64_t *winners);
+};
+
+inline uint64_t xorshift(uint64_t x) {
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return x;
+}
+
+// Índice em [0, popsize) a partir dos 32 bits altos do gerador
+inline uint64_t bounded(uint64_t x, uint64_t popsize) {
+  return ((x >> 32) * popsize) >> 32;
+}
+
+void run_scalar(const double *fitness, uint64_t popsize, unsigned ring,
+    uint64_t *state, size_t blocks, uint64_t *winners) {
+  for (size_t b = 0; b < blocks; b++) {
+    for (size_t l = 0; l < LANES; l++) {
+      state[l] = xorshift(state[l]);
+      uint64_t best = bounded(state[l], popsize);
+      double bestFitness = fitness[best];
+      for (unsigned r = 1; r < ring; r++) {
+        state[l] = xorshift(state[l]);
+        const uint64_t other = bounded(state[l], popsize);
+        if (fitness[other] > bestFitness) {
+          best = other;
+          bestFitness = fitness[other];
+        }
+      }
+      winners[b * LANES + l] = best;
+    }
+  }
+}
+
+#ifdef SIMD_DISPATCH_X86
+__attribute__((target("avx2")))
+inline __m256i xorshift4(__m256i x) {
+  x = _mm256_xor_si256(x, _mm256_slli_epi64(x, 13));
+  x = _mm256_xor_si256(x, _mm256_srli_epi64(x, 7));
+  return _mm256_xor_si256(x, _mm256_slli_epi64(x, 17));
+}
+
+__attribute__((target("avx2")))
+inline __m256i bounded4(__m256i x, __m256i popsize) {
+  return _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(x, 32), popsize), 32);
+}
+
+__attribute__((target("avx2")))
+void run_avx2(const double *fitness, uint64_t popsize, unsigned ring,
+    uint64_t *state, size_t blocks, uint64_t *winners) {
+  const __m256i n = _mm256_set1_epi64x(popsize);
+  __m256i s[2];
+  for (int h = 0; h < 2; h++) {
+    s[h] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 4 * h));
+  }
+  for (size_t b = 0; b < blocks; b++) {
+    // As duas metades do bloco são as lanes 0-3 e 4-7 do kernel escalar
+    for (int h = 0; h < 2; h++) {
+      s[h] = xorshift4(s[h]);
+      __m256i best = bounded4(s[h], n);
+      __m256d bestFitness = _mm256_i64gather_pd(fitness, best, 8);
+      for (unsigned r = 1; r < ring; r++) {
+        s[h] = xorshift4(s[h]);
+        const __m256i other = bounded4(s[h], n);
+        const __m256d f = _mm256_i64gather_pd(fitness, other, 8);
+        const __m256d better = _mm256_cmp_pd(f, bestFitness, _CMP_GT_OQ);
+        bestFitness = _mm256_blendv_pd(bestFitness, f, better);
+        best = _mm256_blendv_epi8(best, other, _mm256_castpd_si256(better));
+      }
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(winners + b * LANES + 4 * h), best);
+    }
+  }
+  for (int h = 0; h < 2; h++) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 4 * h), s[h]);
+  }
+}
+
+__attribute__((target("avx512f")))
+inline __m512i xorshift8(__m512i x) {
+  x = _mm512_xor_si512(x, _mm512_slli_epi64(x, 13));
+  x = _mm512_xor_si512(x, _mm512_srli_epi64(x, 7));
+  return _mm512_xor_si512(x, _mm512_slli_epi64(x, 17));
+}
+
+__attribute__((target("avx512f")))
+void run_avx512(const double *fitness, uint64_t popsize, unsigned ring,
+    uint64_t *state, size_t blocks, uint64_t *winners) {
+  const __m512i n = _mm512_set1_epi64(popsize);
+  __m512i s = _mm512_loadu_si512(state);
+  for (size_t b = 0; b < blocks; b++) {
+    s = xorshift8(s);
+    __m512i best = _mm512_srli_epi64(_mm512_mul_epu32(_mm512_srli_epi64(s, 32), n), 32);
+    __m512d bestFitness = _mm512_i64gather_pd(best, fitness, 8);
+    for (unsigned r = 1; r < ring; r++) {
+      s = xorshift8(s);
+      const __m512i other = _mm512_srli_epi64(_mm512_mul_epu32(_mm512_srli_epi64(s, 32), n), 32);
+      const __m512d f = _mm512_i64gather_pd(other, fitness, 8);
+      const __mmask8 better = _mm512_cmp_pd_mask(f, bestFitness, _CMP_GT_OQ);
+      bestFitness = _mm512_mask_mov_pd(bestFitness, better, f);
+      best = _mm512_mask_mov_epi64(best, better, other);
+    }
+    _mm512_storeu_si512(winners + b * LANES, best);
+  }
+  _mm512_storeu_si512(state, s);
+}
+#endif
+
+const Kernel scalarKernel{"scalar", run_scalar};
+#ifdef SIMD_DISPATCH_X86
+const Kernel avx2Kernel{"avx2", run_avx2};
+const Kernel avx512Kernel{"avx512", run_avx512};
+#endif
+
+SimdDispatch<Kernel> &active() {
+#ifdef SIMD_DISPATCH_X86
+  static SimdDispatch<Kernel> kernels("TournamentSelection", scalarKernel, &avx2Kernel, &avx512Kernel);
+#else
+  static SimdDispatch<Kernel> kernels("TournamentSelection", scalarKernel, nullptr, nullptr);
+#endif
+  return kernels;
+}
+
+uint64_t splitmix64(uint64_t &x) {
+  uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+} // namespace
+
+TournamentSelection::TournamentSelection(unsigned ringSize_)
+  : ringSize(ringSize_ ? ringSize_ : 1) {}
+
+const Chrom &TournamentSelection::operator()(const eoPop<Chrom> &pop) {
+  const Chrom *best = &pop[rng.random(pop.size())];
+  for (unsigned r = 1; r < this->ringSize; r++) {
+    const Chrom &other = pop[rng.random(pop.size())];
+    if (*best < other) best = &other;
+  }
+  return *best;
+}
+
+void TournamentSelection::select(const Fitness *fitness, size_t popsize,
+    size_t count, std::vector<size_t> &winners) {
+  winners.clear();
+  if (popsize == 0 or count == 0) return;
+  if (uint64_t(popsize) > std::numeric_limits<uint32_t>::max()) {
+    throw std::length_error("TournamentSelection: população grande demais");
+  }
+
+  // Geradores das lanes semeados pelo rng do EO, que guarda todo o estado
+  // aleatório da execução
+  uint64_t seed = (uint64_t(rng.rand()) << 32) | rng.rand();
+  uint64_t state[LANES];
+  for (uint64_t &s : state) {
+    s = splitmix64(seed);
+    if (s == 0) s = 0x9e3779b97f4a7c15ULL;
+  }
+
+  // O último bloco é feito inteiro (todos os kernels avançam as 8 lanes) e
+  // os torneios que sobram são descartados
+  const size_t blocks = (count + LANES - 1) / LANES;
+  winners.resize(blocks * LANES);
+  static_assert(sizeof(size_t) == sizeof(uint64_t), "índices de 64 bits");
+  active().get().run(fitness, popsize, this->ringSize, state, blocks,
+      reinterpret_cast<uint64_t*>(winners.data()));
+  winners.resize(count);
+}
+
+void TournamentSelection::select(const eoPop<Chrom> &pop, size_t count,
+    std::vector<size_t> &winners) {
+  this->fitnessValues.resize(pop.size());
+  for (size_t i = 0; i < pop.size(); i++) {
+    this->fitnessValues[i] = pop[i].invalid() ?
+        std::numeric_limits<Fitness>::lowest() : pop[i].fitness();
+  }
+  this->select(this->fitnessValues.data(), pop.size(), count, winners);
+}
+
+const char *TournamentSelection::kernel() {
+  return active().name();
+}
+
+void TournamentSelection::set_kernel(const std::string &name) {
+  active().set(name);
+}
@@ -0,0 +1,63 @@
+#ifndef CROSSOVERRESEARCH_TOURNAMENT_SELECTION_H
+#define CROSSOVERRESEARCH_TOURNAMENT_SELECTION_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <paradiseo/eo/eoSelectOne.h>
+#include "encoding.h"
+
+/**
+ * @class TournamentSelection
+ * Torneio determinístico (como eoDetTournamentSelect) que escolhe os índices
+ * dos vencedores de muitos torneios de uma vez, comparando somente um vetor
+ * contíguo com o fitness dos indivíduos. Os cromossomos não são acessados nem
+ * copiados: cabe ao AG materializar os filhos a partir dos índices.
+ *
+ * Os torneios são feitos em blocos de 8, um por lane, e cada lane tem o seu
+ * gerador xorshift64 (semeado pelo rng do EO a cada chamada, então execuções
+ * com a mesma semente e os checkpoints continuam reprodutíveis). O kernel é
+ * escolhido em tempo de execução (AVX-512, AVX2 ou escalar) e todos sorteiam
+ * os mesmos competidores, então os vencedores não dependem da CPU.
+ *
+ * Como em eoDetTournamentSelect, um competidor só substitui o melhor até
+ * então se tiver fitness estritamente maior.
+ */
+class TournamentSelection : public eoSelectOne<Chrom> {
+public:
+  using Fitness = Chrom::Fitness;
+
+  explicit TournamentSelection(unsigned ringSize_ = 2);
+
+  /**
+   * Um único torneio, para os algoritmos do EO (ex.: eoSelectPerc) */
+  const Chrom &operator()(const eoPop<Chrom> &pop);
+
+  /**
+   * Índices dos vencedores de `count` torneios entre os `popsize` primeiros
+   * valores de `fitness` */
+  void select(const Fitness *fitness, size_t popsize, size_t count,
+      std::vector<size_t> &winners);
+
+  /**
+   * O mesmo sobre uma população; indivíduos inválidos nunca vencem um
+   * competidor válido */
+  void select(const eoPop<Chrom> &pop, size_t count, std::vector<size_t> &winners);
+
+  unsigned ring_size() const { return this->ringSize; }
+
+  /**
+   * Kernel em uso: "avx512", "avx2" ou "scalar" */
+  static const char *kernel();
+
+  /**
+   * Força um kernel (ex.: para comparar nos benchmarks); "auto" volta à
+   * escolha pela CPU. Um kernel que a CPU não suporta é rejeitado */
+  static void set_kernel(const std::string &name);
+
+private:
+  unsigned ringSize;
+  std::vector<Fitness> fitnessValues;  // fitness contíguo da população
+};
+
+#endif //CROSSOVERRESEARCH_TOURNAMENT_SELECTION_H
@@ -0,0 +1,99 @@
+#ifndef UTILS_BOUNDED_QUEUE_H
+#define UTILS_BOUNDED_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+/**
+ * @class BoundedQueue
+ * Fila FIFO de capacidade fixa, sem locks, para vários produtores e vários
+ * consumidores (a fila de Dmitry Vyukov). Cada posição tem um número de
+ * sequência que diz se ela está livre para o próximo produtor ou pronta para
+ * o próximo consumidor, então push e pop só disputam um contador atômico.
+ *
+ * try_push e try_pop nunca bloqueiam: retornam false com a fila cheia ou
+ * vazia e cabe a quem chama decidir como esperar. A capacidade é arredondada
+ * para uma potência de 2.
+ */
+template <typename T>
+class BoundedQueue {
+public:
+  explicit BoundedQueue(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) size *= 2;
+    this->mask = size - 1;
+    this->cells.reset(new Cell[size]);
+    for (size_t i = 0; i < size; i++) {
+      this->cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  BoundedQueue(const BoundedQueue &) = delete;
+  BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+  size_t capacity() const { return this->mask + 1; }
+
+  /**
+   * Move `value` para o fim da fila, se houver espaço */
+  bool try_push(T &value) {
+    size_t pos = this->tail.load(std::memory_order_relaxed);
+    Cell *cell;
+    while (true) {
+      cell = &this->cells[pos & this->mask];
+      const size_t seq = cell->sequence.load(std::memory_order_acquire);
+      const std::ptrdiff_t diff = std::ptrdiff_t(seq) - std::ptrdiff_t(pos);
+      if (diff == 0) {
+        if (this->tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // cheia
+      } else {
+        pos = this->tail.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = std::move(value);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Move o primeiro elemento da fila para `value`, se houver algum */
+  bool try_pop(T &value) {
+    size_t pos = this->head.load(std::memory_order_relaxed);
+    Cell *cell;
+    while (true) {
+      cell = &this->cells[pos & this->mask];
+      const size_t seq = cell->sequence.load(std::memory_order_acquire);
+      const std::ptrdiff_t diff = std::ptrdiff_t(seq) - std::ptrdiff_t(pos + 1);
+      if (diff == 0) {
+        if (this->head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // vazia
+      } else {
+        pos = this->head.load(std::memory_order_relaxed);
+      }
+    }
+    value = std::move(cell->value);
+    cell->sequence.store(pos + this->mask + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  // Produtores e consumidores em linhas de cache diferentes
+  alignas(64) std::atomic<size_t> tail{0};
+  alignas(64) std::atomic<size_t> head{0};
+  alignas(64) std::unique_ptr<Cell[]> cells;
+  size_t mask;
+};
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef UTILS_SIMD_DISPATCH_H
+#define UTILS_SIMD_DISPATCH_H
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define SIMD_DISPATCH_X86 1
+#endif
+
+/**
+ * @class SimdDispatch
+ * Escolha em tempo de execução entre as versões escalar, AVX2 e AVX-512 de
+ * um kernel, usada por LinearObjective e TournamentSelection. `Kernel` é
+ * qualquer tipo com um campo `name`; as versões AVX são nulas fora de x86
+ * (SIMD_DISPATCH_X86 indica quando compilá-las).
+ *
+ * Por padrão usa a versão mais larga que a CPU suporta. set() força uma
+ * versão pelo nome ("scalar", "avx2" ou "avx512", ou "auto" para voltar à
+ * escolha pela CPU) e rejeita as que a CPU não suporta, com `owner` como
+ * prefixo das mensagens de erro.
+ */
+template <typename Kernel>
+class SimdDispatch {
+public:
+  SimdDispatch(const char *owner_, const Kernel &scalar_, const Kernel *avx2_,
+      const Kernel *avx512_)
+    : owner(owner_), scalar(scalar_), avx2(avx2_), avx512(avx512_),
+      current(detect()) {}
+
+  SimdDispatch(const SimdDispatch &) = delete;
+  SimdDispatch &operator=(const SimdDispatch &) = delete;
+
+  // Versão em uso
+  const Kernel &get() const {
+    return *this->current.load(std::memory_order_relaxed);
+  }
+
+  const char *name() const { return this->current.load()->name; }
+
+  void set(const std::string &name) {
+    const Kernel *chosen = nullptr;
+    if (name == "auto") {
+      chosen = this->detect();
+    } else {
+      for (const Kernel *kernel : {&this->scalar, this->avx2, this->avx512}) {
+        if (kernel and name == kernel->name) chosen = kernel;
+      }
+      if (!chosen) {
+        throw std::invalid_argument(std::string(this->owner) + ": kernel desconhecido: " + name);
+      }
+    }
+    if (!this->supported(*chosen)) {
+      throw std::invalid_argument(std::string(this->owner) + ": kernel não suportado pela CPU: " + name);
+    }
+    this->current.store(chosen);
+  }
+
+private:
+  const char *owner;
+  const Kernel &scalar;
+  const Kernel *avx2;
+  const Kernel *avx512;
+  std::atomic<const Kernel*> current;
+
+  bool supported(const Kernel &kernel) const {
+#ifdef SIMD_DISPATCH_X86
+    if (&kernel == this->avx512) return __builtin_cpu_supports("avx512f");
+    if (&kernel == this->avx2) return __builtin_cpu_supports("avx2");
+#endif
+    return &kernel == &this->scalar;
+  }
+
+  const Kernel *detect() const {
+#ifdef SIMD_DISPATCH_X86
+    __builtin_cpu_init();
+    if (this->avx512 and this->supported(*this->avx512)) return this->avx512;
+    if (this->avx2 and this->supported(*this->avx2)) return this->avx2;
+#endif
+    return &this->scalar;
+  }
+};
+
+#endif //UTILS_SIMD_DISPATCH_H
@@ -1,9 +1,11 @@
 #include "trim_filename.h"
+#include <cstring>
 
 /**
  * Corta o caminho do arquivo reduzindo-o a somente o
  * nome do arquivo */
 const char* trim_filename(const char *filename) {
-  std::string str_filename(filename);
-  return (split(str_filename, '/').end()-1)->c_str();
+  // Aponta para dentro de `filename`: não há cópia que deixe de existir
+  const char *slash = std::strrchr(filename, '/');
+  return slash ? slash + 1 : filename;
 }
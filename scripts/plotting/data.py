@@ -11,13 +11,29 @@ class DataSolver:
         return [ float(value) for value in convergence.split(',') ]
 
     @staticmethod
-    def resolve_crossover_name(crossover_id: int) -> str:
+    def resolve_crossover_name(crossover_id: int, crossover_name: str = None) -> str:
+        """
+        Rótulo de um operador de crossover pelo ID numérico (coluna crossover).
+        Operadores sem ID (-1: parametrizados ou próprios do problema) usam o
+        nome registrado na coluna crossover_name
+        """
+        crossover_id = int(crossover_id)
         if crossover_id == 0:
             return 'Uniforme'
         elif crossover_id == 1:
             return 'Um-ponto'
-        elif crossover_id > 1:
-            return f'{int(crossover_id)}-pontos'
+        elif 1 < crossover_id < 100:
+            return f'{crossover_id}-pontos'
+        elif crossover_id == 100:
+            return 'HUX'
+        elif crossover_id == 101:
+            return 'Shuffle'
+        elif crossover_id == 102:
+            return 'Segmentado'
+        elif 200 < crossover_id < 300:
+            return 'RS-' + DataSolver.resolve_crossover_name(crossover_id - 200)
+        elif isinstance(crossover_name, str) and crossover_name:
+            return crossover_name
         else:
             raise ValueError('Impossible resolve the name of crossover operator')
 
@@ -19,11 +19,14 @@ def build_query(tablename, crossover, crossover_rate=1.0, mutation_rate=None):
 # Plota um gráfico de Boxplot comparando os resultados dos 5 operadores de
 # crossover principais estudados. Aplica uma estilização customizado nos boxplots
 # Recece um objeto de conexão com um arquivo SQLite o nome da tabela e o nome da
-# instância do problema.
-def plot_crossover_boxplots(con: sql.Connection, tablename, instance=None, figsize=(11,8)):
+# instância do problema. Outros operadores podem ser escolhidos em "operators",
+# pelo ID (coluna crossover) ou pelo nome canônico (coluna crossover_name, ex.:
+# 'npoint:k=3' ou 'coverage'), necessário para os operadores sem ID (-1).
+def plot_crossover_boxplots(con: sql.Connection, tablename, instance=None, figsize=(11,8),
+        operators=(0, 1, 2, 4, 8)):
     '''Plota grafico de barras com a comparacao dos resultados do crossovers
     '''
-    columns = 'instance_file, crossover, crossover_rate, total_costs '
+    columns = 'instance_file, crossover, crossover_name, crossover_rate, total_costs '
     query = f'select {columns} from {tablename}'
     if instance is not None:
         query += f" where instance_file = '{instance}'"
@@ -32,17 +35,22 @@ def plot_crossover_boxplots(con: sql.Connection, tablename, instance=None, figsi
     df = read_sql_query(query, con)
     
     # Constroi um DataFrame para cada operador de crossover
-    crossover_ids = [0, 1, 2, 4, 8]
     dataframes = dict()
-    for _id in crossover_ids:
-        dataframes[_id] = df.loc[df['crossover'] == _id]
+    labels = list()
+    for op in operators:
+        if isinstance(op, str):
+            dataframes[op] = df.loc[df['crossover_name'] == op]
+            labels.append(op)
+        else:
+            dataframes[op] = df.loc[df['crossover'] == op]
+            labels.append(DataSolver.resolve_crossover_name(op))
     
     # Extrai as series de custos como listas, de cada operador
     all_result_lists = list()
-    for _id in dataframes:
+    for op in dataframes:
         # FIXME: GAMBIARRA, no caso do maxclique, a coluna total_costs esta como TEXT
         # entao nao esta sendo possivel fazer calculos os valores de custos.
-        lista = list(dataframes[_id]['total_costs'])
+        lista = list(dataframes[op]['total_costs'])
         all_result_lists.append([ float(v) for v in lista ])
 
         
@@ -51,7 +59,7 @@ def plot_crossover_boxplots(con: sql.Connection, tablename, instance=None, figsi
     boxplot = ax.boxplot(all_result_lists,
             patch_artist=True,
             showmeans=True,
-            labels=[ DataSolver.resolve_crossover_name(x) for x in [0, 1, 2, 4, 8] ])
+            labels=labels)
     black_boxes(boxplot)
     ax.set_title(f'Resultados para a instância {instance}', fontsize=15)
     return fig, ax
@@ -3,13 +3,18 @@
 
 #define DEBUG 1
 
+#include <algorithm>
 #include <string>
 #include <sstream>
 #include <exception>
 #include <stdexcept>
 #include <utility>
+#include <memory>
 #include <core/ga/encoding.h>
 #include <core/ga/ga_factory.h>
+#include <core/ga/fitness_cache.h>
+#include <core/ga/checkpoint.h>
+#include <core/ga/linear_objective.h>
 #include <core/db/base_model.hpp>
 #include <core/utils/split.h>
 #include <core/cli/parse.h>
@@ -26,8 +31,10 @@ public:
   explicit Runner(std::string instanceFilename)
     : problemInstance(new ConcreteProblem(instanceFilename.c_str()) ) {}
 
-  explicit Runner(ConcreteProblem *instance_ptr)
-    : problemInstance(instance_ptr) {}
+  // `prepared`: a instância já passou pelo pré-processamento e já tem o
+  // decodificador escolhido (ela foi usada por outro Runner)
+  explicit Runner(ConcreteProblem *instance_ptr, bool prepared = false)
+    : problemInstance(instance_ptr), instancePrepared(prepared) {}
 
   ~Runner() = default;
 
@@ -65,6 +72,16 @@ public:
     return this->formattedSolution;
   }
 
+  // Melhor cromossomo da execução, no grafo/ordem do problema pré-processado
+  const Chrom &get_best_solution() {
+    if (!this->wasExecuted) {
+      throw std::runtime_error("Nao pode usar a função antes de executar o algoritmo");
+    }
+    return this->bestSolution;
+  }
+
+  ConcreteProblem &get_problem() { return *this->problemInstance; }
+
   DbModel get_model() {
     if (!this->wasExecuted) {
       throw std::runtime_error("Nao pode usar a função antes de executar o algoritmo");
@@ -77,30 +94,49 @@ public:
     auto filename = *(split(std::string(cliArguments->infile), '/').end()-1);
     this->dbModel = DbModel(cliArguments);
 
-    auto population = this->problemInstance->init_pop(cliArguments->pop_size, 0.25);
-    this->problemInstance->eval(population);
+    // Reduções da instância mudam o tamanho do cromossomo, então vêm antes
+    // de qualquer coisa que dependa dele
+    if (!this->instancePrepared) {
+      this->problemInstance->preprocess(cliArguments->preprocess);
+      this->problemInstance->set_decoder(cliArguments->decoder);
+      this->instancePrepared = true;
+      for (const std::string &report : this->problemInstance->take_reports()) {
+        if (cliArguments->verbose) std::cout << report << std::endl;
+      }
+    }
 
-    this->gaFactory = new EvaluationsGAFactory(*this->problemInstance);
+    // Sem critério composto, -s é o número de avaliações
+    StopLimits stopLimits = StopLimits::parse(cliArguments->stop_spec.empty() ?
+        std::to_string(cliArguments->stop_criteria) : cliArguments->stop_spec);
+    this->gaFactory.reset(new CombinedGAFactory(*this->problemInstance, stopLimits));
+    EvaluationCounter &evaluator = this->gaFactory->get_evaluation_counter();
 
-    GeneticAlgorithm ga = this->gaFactory->make_ga(cliArguments->tour_size,
-        cliArguments->stop_criteria, cliArguments->crossover_id,
-        cliArguments->crossover_rate, cliArguments->mutation_rate);
+    if (cliArguments->cache_mb > 0) {
+      this->fitnessCache.reset(new FitnessCache(
+          size_t(cliArguments->cache_mb) * 1024 * 1024,
+          this->problemInstance->get_chromsize()));
+      evaluator.set_cache(this->fitnessCache.get());
+    }
 
-    // Executar o AG
-    auto start_tpoint = std::chrono::system_clock::now();
-    ga(population); /// A execucao do AG
-    auto end_tpoint = system_clock::now();
-    auto durationMS = duration_cast<milliseconds>(end_tpoint - start_tpoint);
+    // Evolução, no modo de população escolhido
+    Evolution result = !cliArguments->async_spec.empty() ?
+        this->evolve_async(cliArguments, evaluator) : cliArguments->packed ?
+        this->evolve_packed(cliArguments, evaluator) :
+        this->evolve(cliArguments, evaluator);
+    auto durationMS = result.duration;
 
-    Chrom best = population.best_element();
+    const Chrom &best = result.best;
+    this->bestSolution = best;
     double finalcost = this->problemInstance->is_minimization() ?
         double(1/best.fitness()) : best.fitness();
 
     std::vector<int> solution;
      
+    // Índices da instância original (a partir de 1)
     for (size_t i = 0; i < best.size(); i++) {
-      if (best[i]) solution.push_back(i+1);
+      if (best[i]) solution.push_back(this->problemInstance->original_index(i) + 1);
     }
+    std::sort(solution.begin(), solution.end());
 
     // Definicao da saida para o BD
     this->solutionTotalCost = finalcost;
@@ -111,27 +147,296 @@ public:
     this->dbModel.duration_in_ms = durationMS.count();
 
     // Customizando vetor de convergencia de acordo com o tipo de otimizacao
-    std::vector<Chrom> convergence = ga.get_convergence();
-    std::vector<double> convergenceFitness;
+    std::vector<double> convergenceFitness = result.convergence;
     if (this->problemInstance->is_minimization()) {
-      for (Chrom &chrom : convergence) {
-        convergenceFitness.push_back(1/chrom.fitness());
-      }
-    } else {
-      for (Chrom &chrom : convergence) {
-        convergenceFitness.push_back(chrom.fitness());
+      for (double &fitness : convergenceFitness) {
+        fitness = 1/fitness;
       }
     }
 
     this->dbModel.set_convergence(convergenceFitness);
+    this->dbModel.set_phase_times(result.phaseTimes);
+    this->dbModel.set_evaluation_counts(evaluator);
+    if (this->rateControl) {
+      // Taxas que não são fixas ficam só na coluna rates
+      this->dbModel.rates = this->rateControl->log_to_string();
+      if (!cliArguments->crossover_schedule.empty() or cliArguments->self_adaptive)
+        this->dbModel.crossover_rate = -1;
+      if (!cliArguments->mutation_schedule.empty() or cliArguments->self_adaptive)
+        this->dbModel.mutation_rate = -1;
+    }
+    const StopCriteria *stop = this->gaFactory->get_stop_criteria();
+    this->dbModel.stop_rule = stop->get_limits().to_string();
+    this->dbModel.stop_reason = stop->fired();
+    if (stop->target_reached()) {
+      this->dbModel.time_to_target_ms = stop->time_to_target() * 1000;
+      this->dbModel.evals_to_target = stop->evaluations_to_target();
+    }
+    if (this->restartPolicy) {
+      this->dbModel.restarts = this->restartPolicy->restarts();
+    }
+    const AdaptiveCrossover *adaptive = result.adaptive;
+    if (adaptive) {
+      this->dbModel.operator_log = adaptive->log_to_string();
+    }
+
+    if (cliArguments->verbose) {
+      const PhaseTimer &timer = result.phaseTimes;
+      std::cout << "Tempo por fase (ms):\n";
+      for (int p = 0; p < PhaseTimer::num_phases; p++) {
+        auto ph = PhaseTimer::phase(p);
+        std::cout << "  " << PhaseTimer::name(ph) << ": "
+                  << timer.milliseconds(ph) << "\n";
+      }
+      if (cliArguments->packed and this->problemInstance->has_batch_evaluation()) {
+        std::cout << "Avaliação em lote (kernel " << LinearObjective::kernel() << ")\n";
+      }
+      if (result.workers) {
+        std::cout << "Assíncrono: " << result.workers << " workers, profundidade "
+                  << result.depth << ", utilização de "
+                  << result.utilisation * 100 << "%\n";
+      }
+      if (adaptive) {
+        std::cout << "Crossover adaptativo (usos / probabilidade final):\n";
+        for (size_t a = 0; a < adaptive->size(); a++) {
+          std::cout << "  " << adaptive->name(a) << ": "
+                    << adaptive->total_uses(a) << " / "
+                    << adaptive->probability(a) << "\n";
+        }
+      }
+      if (this->rateControl) {
+        std::cout << "Taxas finais: cruzamento "
+                  << this->rateControl->current_crossover() << ", mutação "
+                  << this->rateControl->current_mutation() << "\n";
+      }
+      if (this->restartPolicy) {
+        std::cout << "Reinícios: " << this->restartPolicy->restarts();
+        const char *sep = " (gerações ";
+        for (uint32_t g : this->restartPolicy->generations()) {
+          std::cout << sep << g;
+          sep = ", ";
+        }
+        std::cout << (this->restartPolicy->restarts() ? ")\n" : "\n");
+      }
+      std::cout << "Parada: " << (stop->fired().empty() ? "-" : stop->fired())
+                << " (" << this->dbModel.stop_rule << ")\n";
+      if (stop->target_reached()) {
+        std::cout << "Alvo atingido em " << stop->time_to_target() << " s, "
+                  << stop->evaluations_to_target() << " avaliações\n";
+      }
+      if (this->localSearch) {
+        std::cout << "Busca local: " << evaluator.local_search_moves()
+                  << " movimentos, " << this->localSearch->improved()
+                  << " filhos melhorados\n";
+      }
+      std::cout << "Avaliações: " << evaluator.objective_calls()
+                << " | Reparos: " << evaluator.repair_calls()
+                << " | Acertos de cache: " << evaluator.cache_hits() << "\n";
+    }
+    if (this->fitnessCache) {
+      std::cout << "Cache de fitness: " << this->fitnessCache->capacity()
+                << " entradas, taxa de acerto de "
+                << this->fitnessCache->hit_rate() * 100 << "% ("
+                << this->fitnessCache->collisions() << " colisões)\n";
+    }
 
     this->wasExecuted = true;
   }
 
 private:
+  // Resultado de uma evolução, nos dois modos de população
+  struct Evolution {
+    Chrom best;
+    std::vector<double> convergence;
+    PhaseTimer phaseTimes;
+    const AdaptiveCrossover *adaptive = nullptr;
+    std::chrono::milliseconds duration;
+    // AG assíncrono (workers = 0 nos outros modos)
+    unsigned workers = 0, depth = 0;
+    double utilisation = 0.0;
+  };
+
+  // Evolução com a população de cromossomos (eoPop) do GeneticAlgorithm
+  Evolution evolve(CLI *cliArguments, EvaluationCounter &evaluator) {
+    using namespace std::chrono;
+    // Ao retomar de um checkpoint a população vem do arquivo; caso contrário
+    // é gerada e avaliada aqui
+    const bool resuming = std::string(cliArguments->resume_file) != "";
+    Checkpoint checkpoint;
+    eoPop<Chrom> population;
+    if (resuming) {
+      checkpoint = Checkpoint::load(cliArguments->resume_file);
+      if (checkpoint.population.empty() or
+          checkpoint.population[0].size() != this->problemInstance->get_chromsize()) {
+        throw std::runtime_error("Checkpoint não corresponde à instância do problema");
+      }
+      this->gaFactory->set_progress(checkpoint.generation, checkpoint.elapsed_seconds);
+    } else {
+      population = this->problemInstance->init_pop(cliArguments->pop_size, 0.25);
+      evaluator.evaluate_all(population);
+    }
+
+    this->problemInstance->register_crossovers();
+    GeneticAlgorithm ga = this->gaFactory->make_ga(cliArguments->tour_size,
+        cliArguments->stop_criteria, cliArguments->crossover,
+        cliArguments->crossover_rate, cliArguments->mutation_rate);
+
+    if (resuming) {
+      ga.restore(checkpoint, population);
+    }
+
+    // Taxas controladas durante a execução: cronogramas (quando -c ou -m
+    // não são números) ou auto-adaptativas
+    if (!cliArguments->crossover_schedule.empty() or
+        !cliArguments->mutation_schedule.empty() or cliArguments->self_adaptive) {
+      auto schedule = [&](const std::string &text, double rate) {
+        std::ostringstream fixed;
+        fixed << rate;
+        return RateSchedule::parse(text.empty() ? fixed.str() : text,
+            this->problemInstance->get_chromsize());
+      };
+      this->rateControl.reset(new RateControl(
+          schedule(cliArguments->crossover_schedule, cliArguments->crossover_rate),
+          schedule(cliArguments->mutation_schedule, cliArguments->mutation_rate),
+          cliArguments->self_adaptive, this->problemInstance->get_chromsize()));
+      ga.set_rate_control(this->rateControl.get());
+    }
+
+    if (!cliArguments->restart.empty()) {
+      this->restartPolicy.reset(new RestartPolicy(
+          RestartPolicy::parse(cliArguments->restart)));
+      ga.set_restart_policy(this->restartPolicy.get());
+    }
+
+    if (!cliArguments->local_search.empty()) {
+      this->localSearch.reset(this->problemInstance->create_local_search());
+      if (!this->localSearch) {
+        throw std::runtime_error("O problema não tem busca local");
+      }
+      this->localSearch->set_budget(
+          LocalSearch::Budget::parse(cliArguments->local_search));
+      ga.set_local_search(this->localSearch.get());
+    }
+
+    // Os checkpoints continuam sendo gravados no arquivo de onde a execução
+    // foi retomada se outro não for especificado
+    std::string checkpointFile(cliArguments->checkpoint_file);
+    if (checkpointFile.empty() and resuming) {
+      checkpointFile = cliArguments->resume_file;
+    }
+    if (!checkpointFile.empty()) {
+      ga.set_checkpoint(checkpointFile, cliArguments->checkpoint_every);
+    }
+
+    // Executar o AG
+    auto start_tpoint = std::chrono::system_clock::now();
+    ga(population); /// A execucao do AG
+    auto end_tpoint = system_clock::now();
+    Evolution result;
+    result.duration = duration_cast<milliseconds>(end_tpoint - start_tpoint);
+    if (resuming) {
+      result.duration += milliseconds(int64_t(checkpoint.elapsed_seconds * 1000));
+    }
+    result.best = population.best_element();
+    result.convergence = ga.get_convergence();
+    result.phaseTimes = ga.get_phase_timer();
+    result.adaptive = ga.get_adaptive();
+    return result;
+  }
+
+  // Evolução com a população compacta (-K) do PackedGeneticAlgorithm. A
+  // população inicial é gerada pelo problema em blocos, então nunca há mais
+  // que um bloco de cromossomos separados na memória
+  Evolution evolve_packed(CLI *cliArguments, EvaluationCounter &evaluator) {
+    using namespace std::chrono;
+    if (std::string(cliArguments->resume_file) != "" or
+        std::string(cliArguments->checkpoint_file) != "" or
+        !cliArguments->restart.empty() or !cliArguments->local_search.empty() or
+        cliArguments->self_adaptive) {
+      throw std::runtime_error("A população compacta (-K) não tem checkpoints, "
+          "reinícios, busca local nem taxas auto-adaptativas");
+    }
+    const size_t chromsize = this->problemInstance->get_chromsize();
+    const unsigned int block = 1024;
+    PackedPopulation population(chromsize);
+    population.reserve(cliArguments->pop_size);
+    for (unsigned int done = 0; done < cliArguments->pop_size; done += block) {
+      eoPop<Chrom> part = this->problemInstance->init_pop(
+          std::min(block, cliArguments->pop_size - done), 0.25);
+      evaluator.evaluate_all(part);
+      population.append(part);
+    }
+
+    auto schedule = [&](const std::string &text, double rate) {
+      std::ostringstream fixed;
+      fixed << rate;
+      return RateSchedule::parse(text.empty() ? fixed.str() : text, chromsize);
+    };
+    this->problemInstance->register_crossovers();
+    PackedGeneticAlgorithm ga = this->gaFactory->make_packed_ga(
+        cliArguments->tour_size, cliArguments->stop_criteria, cliArguments->crossover,
+        schedule(cliArguments->crossover_schedule, cliArguments->crossover_rate),
+        schedule(cliArguments->mutation_schedule, cliArguments->mutation_rate));
+
+    auto start_tpoint = steady_clock::now();
+    ga(population);
+    Evolution result;
+    result.duration = duration_cast<milliseconds>(steady_clock::now() - start_tpoint);
+    population.store(population.best(), result.best);
+    result.convergence = ga.get_convergence();
+    result.phaseTimes = ga.get_phase_timer();
+    return result;
+  }
+
+  // Evolução steady-state assíncrona (-A) do AsyncGeneticAlgorithm, com a
+  // população inicial gerada e avaliada como no modo geracional
+  Evolution evolve_async(CLI *cliArguments, EvaluationCounter &evaluator) {
+    using namespace std::chrono;
+    if (cliArguments->packed or std::string(cliArguments->resume_file) != "" or
+        std::string(cliArguments->checkpoint_file) != "" or
+        !cliArguments->restart.empty() or !cliArguments->local_search.empty() or
+        cliArguments->self_adaptive) {
+      throw std::runtime_error("O AG assíncrono (-A) não tem população compacta, "
+          "checkpoints, reinícios, busca local nem taxas auto-adaptativas");
+    }
+    const size_t chromsize = this->problemInstance->get_chromsize();
+    eoPop<Chrom> population = this->problemInstance->init_pop(cliArguments->pop_size, 0.25);
+    evaluator.evaluate_all(population);
+
+    auto schedule = [&](const std::string &text, double rate) {
+      std::ostringstream fixed;
+      fixed << rate;
+      return RateSchedule::parse(text.empty() ? fixed.str() : text, chromsize);
+    };
+    this->problemInstance->register_crossovers();
+    AsyncGeneticAlgorithm ga = this->gaFactory->make_async_ga(
+        cliArguments->tour_size, cliArguments->stop_criteria, cliArguments->crossover,
+        schedule(cliArguments->crossover_schedule, cliArguments->crossover_rate),
+        schedule(cliArguments->mutation_schedule, cliArguments->mutation_rate),
+        AsyncSettings::parse(cliArguments->async_spec));
+
+    auto start_tpoint = steady_clock::now();
+    ga(population);
+    Evolution result;
+    result.duration = duration_cast<milliseconds>(steady_clock::now() - start_tpoint);
+    result.best = population.best_element();
+    result.convergence = ga.get_convergence();
+    result.phaseTimes = ga.get_phase_timer();
+    result.workers = ga.get_workers();
+    result.depth = ga.get_depth();
+    result.utilisation = ga.get_utilisation();
+    return result;
+  }
+
   ConcreteProblem *problemInstance;
-  GAFactory *gaFactory;
+  bool instancePrepared = false;
+  std::unique_ptr<CombinedGAFactory> gaFactory;
+  std::unique_ptr<FitnessCache> fitnessCache;
+  std::unique_ptr<RateControl> rateControl;
+  std::unique_ptr<RestartPolicy> restartPolicy;
+  std::unique_ptr<LocalSearch> localSearch;
   DbModel dbModel;
+  Chrom bestSolution;
   size_t solutionSize;
   float solutionTotalCost;
   std::string formattedSolution;
@@ -0,0 +1,142 @@
+/**
+ * Executável único do estudo, para qualquer problema do ProblemRegistry:
+ *
+ *   crossover-study <problema> -f <instância> [opções]
+ *   crossover-study --sweep <arquivo>
+ *   crossover-study --list
+ *
+ * Chamado por um link com o nome de um problema (ex.: "setcovering"), o nome
+ * do link é o problema, como nos antigos executáveis de cada problema.
+ *
+ * No modo --sweep cada linha não vazia do arquivo (ou da entrada padrão, com
+ * "-") é uma execução no formato "<problema> [opções]" e linhas iniciadas
+ * por '#' são ignoradas. As instâncias carregadas ficam em memória, então
+ * execuções seguidas sobre a mesma instância (com os mesmos -P e -D) não a
+ * leem nem pré-processam de novo, mesmo misturando problemas diferentes.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <getopt.h>
+#include <core/cli/parse.h>
+
+#include "problem_registry.h"
+
+static void usage(const char *program) {
+  std::cout << "Use: " << program << " <problema> -f [input-file] [ARGS] ...\n"
+            << "     " << program << " --sweep <arquivo | ->\n"
+            << "     " << program << " --list\n\n"
+            << "Problemas:\n";
+  for (const auto &entry : ProblemRegistry::list()) {
+    std::cout << "  " << entry.first << ": " << entry.second << "\n";
+  }
+  std::cout << "\nUse \"" << program << " <problema> -h\" para ver as opções.\n";
+}
+
+// Lê os argumentos de uma execução; argv[0] é o nome do problema. No
+// --sweep um erro nos argumentos lança exceção e só falha a sua linha
+static CLI *parse_run(std::vector<char *> &argv, bool exitOnError = true) {
+  optind = 0;  // reinicia o getopt entre execuções
+  return parse(int(argv.size()), argv.data(), exitOnError);
+}
+
+static int single_run(const std::string &problem, int argc, char **argv) {
+  std::vector<char *> args(argv, argv + argc);
+  std::unique_ptr<CLI> cli(parse_run(args));
+  try {
+    std::unique_ptr<ProblemSession> session(
+        ProblemRegistry::create(problem, cli->infile));
+    session->run(cli.get());
+  } catch (std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+static int sweep(const char *filename) {
+  std::ifstream file;
+  if (std::strcmp(filename, "-") != 0) {
+    file.open(filename);
+    if (!file.is_open()) {
+      std::cerr << "Não foi possível abrir " << filename << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  std::istream &in = file.is_open() ? file : std::cin;
+
+  // Instâncias carregadas: (problema, arquivo, -P, -D) -> sessão
+  using Key = std::tuple<std::string, std::string, std::string, std::string>;
+  std::map<Key, std::unique_ptr<ProblemSession>> sessions;
+  unsigned int runs = 0, failures = 0;
+  std::string line;
+
+  while (std::getline(in, line)) {
+    std::istringstream words(line);
+    std::vector<std::string> tokens;
+    for (std::string word; words >> word; ) tokens.push_back(word);
+    if (tokens.empty() or tokens[0][0] == '#') continue;
+
+    std::vector<char *> args;
+    for (std::string &token : tokens) args.push_back(&token[0]);
+    runs++;
+    auto start = std::chrono::steady_clock::now();
+    try {
+      std::unique_ptr<CLI> cli(parse_run(args, false));
+      Key key(tokens[0], cli->infile, cli->preprocess, cli->decoder);
+      auto it = sessions.find(key);
+      if (it == sessions.end()) {
+        std::unique_ptr<ProblemSession> session(
+            ProblemRegistry::create(tokens[0], cli->infile));
+        it = sessions.emplace(key, std::move(session)).first;
+      }
+      it->second->run(cli.get());
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      std::cout << "[" << runs << "] " << line << " (" << elapsed.count()
+                << " s)" << std::endl;
+    } catch (std::exception &e) {
+      failures++;
+      std::cerr << "[" << runs << "] " << line << ": " << e.what() << std::endl;
+    }
+  }
+  std::cout << runs << " execuções, " << failures << " falhas, "
+            << sessions.size() << " instâncias carregadas" << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int main(int argc, char **argv) {
+  // Chamado pelo nome de um problema (link simbólico)
+  std::string program(argv[0]);
+  program = program.substr(program.find_last_of('/') + 1);
+  if (ProblemRegistry::has(program)) {
+    return single_run(program, argc, argv);
+  }
+
+  if (argc < 2 or std::strcmp(argv[1], "-h") == 0
+      or std::strcmp(argv[1], "--help") == 0 or std::strcmp(argv[1], "--list") == 0) {
+    usage(argv[0]);
+    return argc < 2 ? 2 : EXIT_SUCCESS;
+  }
+  if (std::strcmp(argv[1], "--sweep") == 0) {
+    if (argc < 3) {
+      usage(argv[0]);
+      return 2;
+    }
+    return sweep(argv[2]);
+  }
+  if (!ProblemRegistry::has(argv[1])) {
+    std::cerr << "Problema desconhecido: " << argv[1] << "\n\n";
+    usage(argv[0]);
+    return 2;
+  }
+  return single_run(argv[1], argc - 1, argv + 1);
+}
@@ -0,0 +1,235 @@
+#include "graph_loader.h"
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * Cursor sobre o conteúdo mapeado do arquivo */
+struct scanner {
+  const char *pos, *end;
+
+  bool at_end() const { return this->pos >= this->end; }
+
+  void skip_blanks() {
+    while (this->pos < this->end and (*this->pos == ' ' or *this->pos == '\t'
+        or *this->pos == '\r')) {
+      this->pos++;
+    }
+  }
+
+  void next_line() {
+    while (this->pos < this->end and *this->pos != '\n') this->pos++;
+    if (this->pos < this->end) this->pos++;
+  }
+
+  // Lê um inteiro sem sinal da linha corrente; false se não houver
+  bool number(uint64_t &value) {
+    this->skip_blanks();
+    if (this->pos >= this->end or *this->pos < '0' or *this->pos > '9') {
+      return false;
+    }
+    value = 0;
+    while (this->pos < this->end and *this->pos >= '0' and *this->pos <= '9') {
+      value = value * 10 + uint64_t(*this->pos - '0');
+      this->pos++;
+    }
+    return true;
+  }
+
+  // Pula uma palavra da linha corrente (ex.: "edge" em "p edge V E")
+  void word() {
+    this->skip_blanks();
+    while (this->pos < this->end and *this->pos != ' ' and *this->pos != '\t'
+        and *this->pos != '\n') {
+      this->pos++;
+    }
+  }
+};
+
+/**
+ * Arquivo mapeado em memória, desfeito na destruição */
+struct mapped_file {
+  int fd = -1;
+  const char *data = nullptr;
+  size_t size = 0;
+
+  explicit mapped_file(const std::string &filename) {
+    this->fd = ::open(filename.c_str(), O_RDONLY);
+    if (this->fd < 0) {
+      throw std::runtime_error("Não foi possível abrir o grafo: " + filename);
+    }
+    struct stat info;
+    if (::fstat(this->fd, &info) < 0 or info.st_size == 0) {
+      ::close(this->fd);
+      throw std::runtime_error("Arquivo de grafo vazio ou ilegível: " + filename);
+    }
+    this->size = size_t(info.st_size);
+    void *addr = ::mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, this->fd, 0);
+    if (addr == MAP_FAILED) {
+      ::close(this->fd);
+      throw std::runtime_error("Falha no mmap do grafo: " + filename);
+    }
+    ::madvise(addr, this->size, MADV_SEQUENTIAL);
+    this->data = static_cast<const char *>(addr);
+  }
+
+  ~mapped_file() {
+    ::munmap(const_cast<char *>(this->data), this->size);
+    ::close(this->fd);
+  }
+};
+
+} // namespace
+
+void packed_graph::resize(size_t nodes) {
+  this->num_nodes = nodes;
+  this->num_edges = 0;
+  this->words = packed::num_words(nodes);
+  this->adjacency.assign(nodes * this->words, 0);
+  this->degrees.assign(nodes, 0);
+  this->weights.resize(nodes);
+  for (size_t v = 0; v < nodes; v++) {
+    this->weights[v] = int((v + 1) % 200) + 1;
+  }
+}
+
+void packed_graph::add_edge(size_t u, size_t v) {
+  if (u == v) return;
+  if (u >= this->num_nodes or v >= this->num_nodes) {
+    throw std::runtime_error("Aresta com vértice fora do grafo");
+  }
+  packed::word_t &uv = this->adjacency[u * this->words + v / packed::WORD_BITS];
+  const packed::word_t bit = packed::word_t(1) << (v % packed::WORD_BITS);
+  if (uv & bit) return;  // aresta repetida
+  uv |= bit;
+  this->adjacency[v * this->words + u / packed::WORD_BITS] |=
+      packed::word_t(1) << (u % packed::WORD_BITS);
+  this->degrees[u]++;
+  this->degrees[v]++;
+  this->num_edges++;
+}
+
+packed_graph packed_graph::load(const std::string &filename, fmt mode) {
+  auto start = std::chrono::steady_clock::now();
+  mapped_file file(filename);
+  scanner in{file.data, file.data + file.size};
+
+  if (mode == detect) {
+    const bool mtx = filename.size() > 4
+        and filename.compare(filename.size() - 4, 4, ".mtx") == 0;
+    mode = (mtx or file.data[0] == '%') ? networkrepo : dimacs;
+  }
+
+  packed_graph graph;
+  bool header = false;
+  uint64_t a, b, c;
+  for (; !in.at_end(); in.next_line()) {
+    in.skip_blanks();
+    if (in.at_end()) break;
+    const char tag = *in.pos;
+
+    if (mode == dimacs) {
+      if (tag == 'p') {
+        in.pos++;
+        in.word();
+        if (!in.number(a)) throw std::runtime_error("Linha \"p\" inválida");
+        graph.resize(a);
+        header = true;
+      } else if (tag == 'e' and header) {
+        in.pos++;
+        if (in.number(a) and in.number(b) and a > 0 and b > 0) {
+          graph.add_edge(a - 1, b - 1);
+        }
+      } else if (tag == 'n' and header) {
+        in.pos++;
+        if (in.number(a) and in.number(b) and a > 0 and a <= graph.num_nodes) {
+          graph.weights[a - 1] = int(b);
+        }
+      }
+    } else {
+      if (tag == '%' or tag == '#' or tag == '\n') continue;
+      if (!in.number(a) or !in.number(b)) continue;
+      if (!header) {
+        // "V V E" (Matrix Market) ou "V E"
+        graph.resize(in.number(c) ? std::max(a, b) : a);
+        header = true;
+      } else if (a > 0 and b > 0) {
+        graph.add_edge(a - 1, b - 1);
+      }
+    }
+  }
+  if (!header) {
+    throw std::runtime_error("Arquivo sem cabeçalho de grafo: " + filename);
+  }
+
+  graph.file_bytes = file.size;
+  graph.load_ms = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count();
+  return graph;
+}
+
+std::string packed_graph::load_report() const {
+  const double seconds = std::max(this->load_ms, 1e-6) / 1000;
+  std::stringstream ss;
+  ss << this->num_nodes << " vértices, " << this->num_edges << " arestas lidas em "
+     << this->load_ms << " ms (" << this->file_bytes / 1048576.0 / seconds
+     << " MB/s, " << this->num_edges / seconds << " arestas/s)";
+  return ss.str();
+}
+
+packed_graph packed_graph::induced(const std::vector<size_t> &order) const {
+  packed_graph graph;
+  graph.resize(order.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    graph.weights[i] = this->weights[order[i]];
+    for (size_t k = i + 1; k < order.size(); k++) {
+      if (this->adjacent(order[i], order[k])) graph.add_edge(i, k);
+    }
+  }
+  graph.file_bytes = this->file_bytes;
+  graph.load_ms = this->load_ms;
+  return graph;
+}
+
+std::vector<size_t> packed_graph::degeneracy_order(std::vector<int> *cores) const {
+  // Baldes de vértices por grau restante
+  const size_t n = this->num_nodes;
+  std::vector<int> degree(this->degrees);
+  std::vector<std::vector<size_t>> buckets(n + 1);
+  for (size_t v = 0; v < n; v++) buckets[degree[v]].push_back(v);
+
+  std::vector<bool> removed(n, false);
+  std::vector<size_t> order;
+  order.reserve(n);
+  if (cores) cores->assign(n, 0);
+  size_t current = 0, core = 0;
+  while (order.size() < n) {
+    // Um grau pode voltar a ser o menor depois de uma remoção
+    if (current > 0) current--;
+    while (buckets[current].empty()) current++;
+    const size_t v = buckets[current].back();
+    buckets[current].pop_back();
+    if (removed[v] or degree[v] != int(current)) continue;  // entrada antiga
+
+    removed[v] = true;
+    order.push_back(v);
+    core = std::max(core, current);
+    if (cores) (*cores)[v] = int(core);
+    const packed::word_t *neighbours = this->row(v);
+    for (size_t w = 0; w < this->words; w++) {
+      for (packed::word_t bits = neighbours[w]; bits; bits &= bits - 1) {
+        const size_t u = w * packed::WORD_BITS + __builtin_ctzll(bits);
+        if (!removed[u]) buckets[--degree[u]].push_back(u);
+      }
+    }
+  }
+  std::reverse(order.begin(), order.end());
+  return order;
+}
@@ -0,0 +1,74 @@
+#ifndef MAXCLIQUE_GRAPH_LOADER_H_
+#define MAXCLIQUE_GRAPH_LOADER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <core/ga/packed_bits.h>
+
+/**
+ * @struct packed_graph
+ * Grafo não direcionado com pesos nos vértices e adjacência em linhas de
+ * bits compactadas (como em packed::pack), sem laços: o bit v da linha u
+ * indica a aresta {u, v}.
+ */
+struct packed_graph {
+  // Formatos de arquivo aceitos pelo load
+  enum fmt { detect, dimacs, networkrepo };
+
+  size_t num_nodes = 0;
+  size_t num_edges = 0;    // arestas distintas (repetições são ignoradas)
+  size_t words = 0;        // palavras por linha de adjacência
+  std::vector<packed::word_t> adjacency;
+  std::vector<int> degrees;
+  std::vector<int> weights;
+
+  // Estatísticas da última leitura
+  size_t file_bytes = 0;
+  double load_ms = 0.0;
+
+  const packed::word_t *row(size_t v) const {
+    return this->adjacency.data() + v * this->words;
+  }
+
+  bool adjacent(size_t u, size_t v) const {
+    return (this->row(u)[v / packed::WORD_BITS] >> (v % packed::WORD_BITS)) & 1;
+  }
+
+  /**
+   * Lê o grafo em uma única passada sobre o arquivo mapeado em memória
+   * (mmap), montando diretamente as linhas de bits, os graus e os pesos.
+   *
+   * DIMACS: linhas "c" (comentário), "p edge V E", "n v peso" e "e u v".
+   * networkrepository (.mtx): linhas "%" (comentário), uma linha "V V E" ou
+   * "V E" e depois uma aresta "u v [peso]" por linha.
+   *
+   * Vértices começam em 1. Sem linhas "n", o peso do vértice v (a partir de
+   * 1) é (v mod 200) + 1, a convenção usual das instâncias DIMACS-W. Com
+   * `detect` o formato é escolhido pela extensão .mtx ou por um "%" no
+   * início do arquivo. */
+  static packed_graph load(const std::string &filename, fmt mode = detect);
+
+  /**
+   * Resumo da leitura: tamanho do grafo e vazão (MB/s e arestas/s) */
+  std::string load_report() const;
+
+  /**
+   * Subgrafo induzido pelos vértices de `order`: o vértice i do novo grafo
+   * é o vértice order[i] deste, com o seu peso */
+  packed_graph induced(const std::vector<size_t> &order) const;
+
+  /**
+   * Ordem de degeneração invertida: os vértices são removidos um a um pelo
+   * menor grau restante e a ordem devolvida começa pelo último removido,
+   * então os vértices do núcleo mais denso ficam juntos no início. Se
+   * `cores` não for nulo, recebe o número de núcleo (core number) de cada
+   * vértice: um clique com v tem no máximo cores[v] + 1 vértices */
+  std::vector<size_t> degeneracy_order(std::vector<int> *cores = nullptr) const;
+
+private:
+  void resize(size_t nodes);
+  void add_edge(size_t u, size_t v);
+};
+
+#endif // MAXCLIQUE_GRAPH_LOADER_H_
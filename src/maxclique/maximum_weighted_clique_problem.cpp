@@ -1,17 +1,15 @@
 #include "maximum_weighted_clique_problem.h"
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
 
 MWCProblem::MWCProblem(const char *filepath) {
-  std::ifstream file(filepath);
-  this->mat = weighted_matrix::read_file(file);
-  this->chromSize = mat.get_num_nodes();
+  this->graph = std::make_shared<const packed_graph>(packed_graph::load(filepath));
+  this->chromSize = this->graph->num_nodes;
   this->minimization = false;
   this->instanceFilename = (char *)filepath;
-
-  // Criar um vector para mapear os graus de cada nó
-  degrees = std::vector<int>(this->chromSize);
-  for (size_t i = 0; i < (size_t)this->chromSize; i++) {
-    degrees[i] = std::accumulate( mat[i].begin(), mat[i].end(), 0 );
-  }
+  this->reports.push_back("Grafo: " + this->graph->load_report());
 }
 
 MWCProblem::~MWCProblem() = default;
@@ -20,17 +18,34 @@ eoPop<Chrom> MWCProblem::init_pop(uint length, double bias) {
   return Random<Chrom>::population(this->chromSize, length, bias);
 }
 
+bool MWCProblem::is_clique(const Chrom& chrom) {
+  packed::pack(chrom, this->members);
+  // Cada vértice do clique precisa ter todos os outros na sua vizinhança
+  for (size_t w = 0; w < this->graph->words; w++) {
+    for (packed::word_t bits = this->members[w]; bits; bits &= bits - 1) {
+      const size_t v = w * packed::WORD_BITS + __builtin_ctzll(bits);
+      const packed::word_t *neighbours = this->graph->row(v);
+      for (size_t x = 0; x < this->graph->words; x++) {
+        packed::word_t others = this->members[x];
+        if (x == w) others &= ~(packed::word_t(1) << (v % packed::WORD_BITS));
+        if (others & ~neighbours[x]) return false;
+      }
+    }
+  }
+  return true;
+}
+
 /**
  * Repair Clique procura o vértice incluso na solução que tem o menor grau,
  * e o remove. */
 void MWCProblem::repair_clique(Chrom& chrom) {
-  while (!mat.is_clique(chrom)) {
+  while (!this->is_clique(chrom)) {
     int index;
     int minor = std::numeric_limits<int>::max();
     
     for (size_t i = 0; i < this->chromSize; i++) {
-      if (chrom[i] and degrees[i] < minor) {
-        minor = degrees[i]; index=i;
+      if (chrom[i] and this->graph->degrees[i] < minor) {
+        minor = this->graph->degrees[i]; index=i;
       }
     } 
     chrom[index] = 0;
@@ -38,52 +53,249 @@ void MWCProblem::repair_clique(Chrom& chrom) {
 }
 
 
-void MWCProblem::expand_clique(Chrom& chrom, uint gene_index) {
-  assert(gene_index < chrom.size());
-  // Pré-processamento:
-  // Índices dos vértices presentes e não presentes na solução
-  // são armazenados em vectors separados para controle
-  std::vector<int> included, excluded;
-  for (size_t i = 0; i < chrom.size(); i++) {
-    if (chrom[i]) {
-      included.push_back(i);
-    } else if (i >= gene_index) {
-      excluded.push_back(i);
+void MWCProblem::expand_clique(Chrom& chrom) {
+  // Candidatos: vértices adjacentes a todos os vértices do clique
+  packed::pack(chrom, this->members);
+  this->candidates.assign(this->graph->words, ~packed::word_t(0));
+  const size_t tail = this->chromSize % packed::WORD_BITS;
+  if (tail) {
+    this->candidates.back() = (packed::word_t(1) << tail) - 1;
+  }
+  for (size_t w = 0; w < this->graph->words; w++) {
+    for (packed::word_t bits = this->members[w]; bits; bits &= bits - 1) {
+      const size_t v = w * packed::WORD_BITS + __builtin_ctzll(bits);
+      const packed::word_t *neighbours = this->graph->row(v);
+      for (size_t x = 0; x < this->graph->words; x++) {
+        this->candidates[x] &= neighbours[x];
+      }
     }
   }
 
-  // Pra cada vértice que não está incluído na solução,
-  // é vericado se ele está conectado a todos os vértices incluídos
-  // para então adicioná-lo.
-  for (int v : excluded) {
-    bool add = true;
-    for (int u : included) {
-      if (!mat[v][u] and v != u) {
-        add = false;
-        break;
+  while (true) {
+    // Candidato de maior prioridade, com empates sorteados
+    long chosen = -1;
+    double best = 0.0;
+    unsigned ties = 0;
+    for (size_t w = 0; w < this->graph->words; w++) {
+      for (packed::word_t bits = this->candidates[w]; bits; bits &= bits - 1) {
+        const size_t v = w * packed::WORD_BITS + __builtin_ctzll(bits);
+        double priority = this->graph->weights[v];
+        if (this->expansionRule == by_weight_degree) {
+          priority /= std::max(1, this->graph->degrees[v]);
+        }
+        if (chosen < 0 or priority > best) {
+          chosen = v; best = priority; ties = 1;
+        } else if (priority == best and rng.random(++ties) == 0) {
+          chosen = v;
+        }
       }
     }
-    if (add) {
-      chrom[v] = 1; // add this node in chromosome
-      included.push_back(v); // add on the included vector
+    if (chosen < 0) break;
+
+    chrom[chosen] = 1;
+    const packed::word_t *neighbours = this->graph->row(chosen);
+    for (size_t x = 0; x < this->graph->words; x++) {
+      this->candidates[x] &= neighbours[x];
     }
   }
 }
 
 
-void MWCProblem::operator()(Chrom &chrom) {
+void MWCProblem::repair(Chrom &chrom) {
   repair_clique(chrom);
-  random_generator<int> rg(this->chromSize);
-  int r = rg();
-  expand_clique(chrom, r);
+  expand_clique(chrom);
+}
+
 
-  if (mat.is_clique(chrom)) {
+void MWCProblem::operator()(Chrom &chrom) {
+  if (this->is_clique(chrom)) {
     int sum = 0;
     for (size_t i=0; i < chrom.size(); i++) {
-      sum += chrom[i] * mat.get_weight(i);
+      sum += chrom[i] * this->graph->weights[i];
     }
     chrom.fitness(sum);
   } else {
     chrom.fitness(0);
   }
 }
+
+
+void MWCProblem::register_crossovers() {
+  CrossoverFabric::add("clique",
+      "Interseção dos cliques dos pais estendida com vértices da união",
+      // Captura o grafo atual, que vive enquanto houver operador
+      [graph = this->graph](const CrossoverSpec &spec) -> eoQuadOp<Chrom>* {
+        spec.check_params({});
+        return new CliqueIntersectionCrossover(graph);
+      });
+}
+
+
+CliqueIntersectionCrossover::CliqueIntersectionCrossover(
+    std::shared_ptr<const packed_graph> graph)
+  : graph(std::move(graph)) {}
+
+bool CliqueIntersectionCrossover::operator()(Chrom &chrom1, Chrom &chrom2) {
+  this->parent1 = chrom1;
+  this->parent2 = chrom2;
+  this->make_child(this->parent1, this->parent2, chrom1);
+  this->make_child(this->parent2, this->parent1, chrom2);
+  return chrom1 != this->parent1 or chrom2 != this->parent2;
+}
+
+void CliqueIntersectionCrossover::make_child(const Chrom &first,
+    const Chrom &second, Chrom &child) {
+  this->members.clear();
+  for (size_t v = 0; v < child.size(); v++) {
+    child[v] = first[v] and second[v];
+    if (child[v]) this->members.push_back(v);
+  }
+
+  // Vértices exclusivos do pai principal e depois os do outro pai
+  for (const Chrom *parent : {&first, &second}) {
+    this->candidates.clear();
+    for (size_t v = 0; v < child.size(); v++) {
+      if ((*parent)[v] and !child[v]) this->candidates.push_back(v);
+    }
+    this->extend(child);
+  }
+}
+
+void CliqueIntersectionCrossover::extend(Chrom &child) {
+  for (size_t i = this->candidates.size(); i > 1; i--) {
+    std::swap(this->candidates[i - 1], this->candidates[rng.random(i)]);
+  }
+  for (uint v : this->candidates) {
+    bool add = !child[v];
+    for (size_t i = 0; add and i < this->members.size(); i++) {
+      add = this->graph->adjacent(v, this->members[i]);
+    }
+    if (add) {
+      child[v] = true;
+      this->members.push_back(v);
+    }
+  }
+}
+
+
+void MWCProblem::set_decoder(const std::string &name) {
+  if (name.empty() or name == "weight") {
+    this->set_expansion(by_weight);
+  } else if (name == "weight-degree") {
+    this->set_expansion(by_weight_degree);
+  } else {
+    throw std::invalid_argument("Decodificador desconhecido: " + name
+        + " (use weight ou weight-degree)");
+  }
+}
+
+size_t MWCProblem::original_index(size_t gene) const {
+  return this->originalIds.empty() ? gene : this->originalIds[gene];
+}
+
+int MWCProblem::greedy_bound(Chrom &best) {
+  const expansion rule = this->expansionRule;
+  this->expansionRule = by_weight;
+  int bound = 0;
+  Chrom clique(this->chromSize);
+  for (size_t v = 0; v < this->chromSize; v++) {
+    std::fill(clique.begin(), clique.end(), false);
+    clique[v] = true;
+    this->expand_clique(clique);
+    int weight = 0;
+    for (size_t u = 0; u < this->chromSize; u++) {
+      if (clique[u]) weight += this->graph->weights[u];
+    }
+    if (weight > bound) {
+      bound = weight;
+      best = clique;
+    }
+  }
+  this->expansionRule = rule;
+  return bound;
+}
+
+void MWCProblem::preprocess(const std::string &spec_) {
+  if (spec_.empty()) return;
+  // Mesmo formato de parâmetros dos operadores de crossover
+  const CrossoverSpec spec = CrossoverSpec::parse("preprocess:" + spec_);
+  spec.check_params({"order", "prune"});
+  auto it = spec.params.find("order");
+  const std::string order = it == spec.params.end() ? "degeneracy" : it->second;
+  if (order != "degeneracy" and order != "weight" and order != "none") {
+    throw std::invalid_argument("preprocess: order deve ser degeneracy, "
+        "weight ou none");
+  }
+  const size_t before = this->chromSize;
+
+  // Vértice do grafo corrente -> vértice do grafo antes da redução
+  std::vector<size_t> ids(this->chromSize);
+  std::iota(ids.begin(), ids.end(), 0);
+  int bound = 0;
+  if (spec.get("prune", 1) != 0) {
+    Chrom best;
+    bound = this->greedy_bound(best);
+
+    // Um clique com v tem no máximo cores[v] vizinhos de v, então o peso de
+    // v mais os cores[v] vizinhos mais pesados limita o peso desse clique.
+    // Remover vértices diminui os núcleos, então repete até estabilizar
+    std::vector<int> cores, neighbourWeights;
+    std::vector<size_t> keep;
+    while (true) {
+      this->graph->degeneracy_order(&cores);
+      keep.clear();
+      for (size_t v = 0; v < this->chromSize; v++) {
+        neighbourWeights.clear();
+        const packed::word_t *neighbours = this->graph->row(v);
+        for (size_t w = 0; w < this->graph->words; w++) {
+          for (packed::word_t bits = neighbours[w]; bits; bits &= bits - 1) {
+            const size_t u = w * packed::WORD_BITS + __builtin_ctzll(bits);
+            neighbourWeights.push_back(this->graph->weights[u]);
+          }
+        }
+        const size_t k = std::min<size_t>(cores[v], neighbourWeights.size());
+        std::nth_element(neighbourWeights.begin(), neighbourWeights.begin() + k,
+            neighbourWeights.end(), std::greater<int>());
+        const long upper = this->graph->weights[v] + std::accumulate(
+            neighbourWeights.begin(), neighbourWeights.begin() + k, 0L);
+        if (upper > bound or best[v]) keep.push_back(v);
+      }
+      if (keep.size() == this->chromSize) break;
+
+      Chrom kept(keep.size());
+      std::vector<size_t> keptIds(keep.size());
+      for (size_t i = 0; i < keep.size(); i++) {
+        kept[i] = best[keep[i]];
+        keptIds[i] = ids[keep[i]];
+      }
+      best.swap(kept);
+      ids.swap(keptIds);
+      this->graph = std::make_shared<const packed_graph>(this->graph->induced(keep));
+      this->chromSize = this->graph->num_nodes;
+    }
+  }
+
+  std::vector<size_t> vertices;
+  if (order == "degeneracy") {
+    vertices = this->graph->degeneracy_order();
+  } else {
+    vertices.resize(this->chromSize);
+    std::iota(vertices.begin(), vertices.end(), 0);
+    if (order == "weight") {
+      const std::vector<int> &weights = this->graph->weights;
+      std::stable_sort(vertices.begin(), vertices.end(),
+          [&weights](size_t a, size_t b) { return weights[a] > weights[b]; });
+    }
+  }
+  this->graph = std::make_shared<const packed_graph>(this->graph->induced(vertices));
+  for (size_t &v : vertices) {
+    v = this->originalIds.empty() ? ids[v] : this->originalIds[ids[v]];
+  }
+  this->originalIds = vertices;
+  this->chromSize = this->graph->num_nodes;
+
+  std::stringstream report;
+  report << "Pré-processamento: " << before << " -> " << this->chromSize
+         << " vértices (limite guloso " << bound << ", ordem " << order << ")";
+  this->reports.push_back(report.str());
+}
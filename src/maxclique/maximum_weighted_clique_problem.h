@@ -3,9 +3,12 @@
 
 #include <numeric>
 #include <limits>
+#include <memory>
 #include <core/ga/problem.h>
 #include <core/ga/random.h>
-#include "weighted_matrix.hpp"
+#include <core/ga/crossover_fabric.h>
+#include <core/ga/packed_bits.h>
+#include "graph_loader.h"
 
 class MWCProblem : public Problem {
 public:
@@ -18,12 +21,86 @@ public:
 
   void operator()(Chrom &chrom);
 
+  // Remove vértices até formar um clique e depois tenta expandi-lo
+  void repair(Chrom &chrom);
+
+  // Critério de escolha do próximo vértice na expansão do clique
+  enum expansion { by_weight, by_weight_degree };
+
   void repair_clique(Chrom& chrom);
-  void expand_clique(Chrom& chrom, uint gene_index);
+
+  /**
+   * Expansão gulosa do clique sobre as linhas de adjacência compactadas: os
+   * candidatos são a interseção das vizinhanças dos vértices do clique e, a
+   * cada passo, o candidato de maior peso (ou peso/grau) entra e a sua
+   * vizinhança é intersectada com os candidatos, tudo em operações de
+   * palavra. Empates são sorteados. */
+  void expand_clique(Chrom& chrom);
+
+  void set_expansion(expansion rule) { this->expansionRule = rule; }
+
+  /**
+   * Escolhe a regra da expansão do clique no reparo: "weight" (padrão, maior
+   * peso) ou "weight-degree" (maior peso/grau) */
+  void set_decoder(const std::string &name);
+
+  // Verifica se os vértices do cromossomo formam um clique
+  bool is_clique(const Chrom& chrom);
+
+  // Registra o crossover "clique" (CliqueIntersectionCrossover)
+  void register_crossovers();
+
+  /**
+   * Reduz e reordena o grafo: "order=degeneracy|weight|none,prune=1".
+   * Com prune, um clique guloso dá o limite inferior L e são removidos
+   * (repetidamente) os vértices v cujo peso somado ao dos core(v) vizinhos
+   * mais pesados não passa de L, exceto os do próprio clique guloso: eles
+   * não podem estar em um clique mais pesado. Os vértices restantes são ordenados pela ordem
+   * de degeneração invertida (núcleo denso primeiro), por peso decrescente
+   * ou mantidos na ordem original. */
+  void preprocess(const std::string &spec);
+
+  size_t original_index(size_t gene) const;
+
+  // Verifica se dois vértices distintos são adjacentes
+  bool adjacent(uint u, uint v) const { return this->graph->adjacent(u, v); }
+
+  const packed_graph &get_graph() const { return *this->graph; }
+
+private:
+  // Adjacências compactadas, graus e pesos. Só é trocado inteiro (na
+  // redução), então é compartilhado com o crossover "clique"
+  std::shared_ptr<const packed_graph> graph;
+  std::vector<size_t> originalIds; // vértice original de cada gene (se reduzido)
+  expansion expansionRule = by_weight;
+  std::vector<packed::word_t> members, candidates; // usados no reparo
+
+  // Peso do clique guloso de maior peso iniciado em cada vértice
+  int greedy_bound(Chrom &best);
+};
+
+/**
+ * Crossover de interseção de cliques: cada filho começa com os vértices
+ * comuns aos dois pais (a interseção de dois cliques é um clique) e recebe,
+ * em ordem aleatória, vértices que só um dos pais tem, primeiro os do seu pai
+ * principal, desde que sejam adjacentes a todos os vértices já incluídos.
+ * Filhos de cliques são sempre cliques.
+ */
+class CliqueIntersectionCrossover : public eoQuadOp<Chrom> {
+public:
+  explicit CliqueIntersectionCrossover(std::shared_ptr<const packed_graph> graph);
+
+  bool operator()(Chrom &chrom1, Chrom &chrom2);
+
+  std::string className() const { return "CliqueIntersectionCrossover"; }
 
 private:
-  weighted_matrix mat; // matriz de adjacências
-  std::vector<int> degrees; // vetor de graus
+  std::shared_ptr<const packed_graph> graph;
+  Chrom parent1, parent2;
+  std::vector<uint> members, candidates;
+
+  void make_child(const Chrom &first, const Chrom &second, Chrom &child);
+  void extend(Chrom &child);
 };
 
 #endif
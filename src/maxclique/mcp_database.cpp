@@ -8,8 +8,7 @@ MCPModel::MCPModel(CLI *cli)
   this->stop_criteria = cli->stop_criteria;
   this->mutation_rate = cli->mutation_rate;
   this->crossover_rate = cli->crossover_rate;
-  this->crossover_id = cli->crossover_id;
-  this->crossover_name = CrossoverFabric::name(cli->crossover_id);
+  this->set_crossover(cli->crossover);
   const char *aux = trim_filename(cli->infile);
   this->instance_file = std::string(aux);
   this->solution_size = 0;
@@ -35,9 +34,22 @@ void MCPModel::create(sqlite::connection *con) {
   query += "solution TEXT, ";
   query += "total_costs TEXT, ";
   query += "convergence TEXT, ";
-  query += "duration_in_ms REAL";
+  query += "duration_in_ms REAL, ";
+  query += "phase_times TEXT, ";
+  query += "objective_calls INTEGER, ";
+  query += "repair_calls INTEGER, ";
+  query += "cache_hits INTEGER, ";
+  query += "local_search_moves INTEGER, ";
+  query += "operator_log TEXT, ";
+  query += "rates TEXT, ";
+  query += "restarts INTEGER, ";
+  query += "stop_rule TEXT, ";
+  query += "stop_reason TEXT, ";
+  query += "time_to_target_ms REAL, ";
+  query += "evals_to_target INTEGER";
   query += ");";
   sqlite::execute(*con, query, true);
+  this->migrate(con);
 }
 
 void MCPModel::insert(sqlite::connection *con) {
@@ -45,13 +57,21 @@ void MCPModel::insert(sqlite::connection *con) {
   sql = "INSERT INTO " + std::string(this->table_name) + " (";
   sql += "population_size, stop_criteria, crossover, crossover_name, ";
   sql += "crossover_rate, mutation_rate, instance_file, convergence, ";
-  sql += "duration_in_ms, solution_size, solution, total_costs";
-  sql += ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
+  sql += "duration_in_ms, phase_times, objective_calls, repair_calls, ";
+  sql += "cache_hits, local_search_moves, operator_log, rates, restarts, ";
+  sql += "stop_rule, stop_reason, time_to_target_ms, evals_to_target, ";
+  sql += "solution_size, solution, total_costs";
+  sql += ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ";
+  sql += "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
 
   sqlite::execute ins(*con, sql);
-  ins % this->population_size % this->stop_criteria   % this->crossover_id
-      % this->crossover_name  % this->crossover_rate  % this->mutation_rate
-      % this->instance_file   % this->convergence     % this->duration_in_ms 
-      % this->solution_size   % this->solution        % this->total_cost;
+  ins % this->population_size    % this->stop_criteria      % this->crossover_id
+      % this->crossover_name     % this->crossover_rate     % this->mutation_rate
+      % this->instance_file      % this->convergence        % this->duration_in_ms
+      % this->phase_times        % this->objective_calls    % this->repair_calls
+      % this->cache_hits         % this->local_search_moves % this->operator_log
+      % this->rates              % this->restarts           % this->stop_rule
+      % this->stop_reason        % this->time_to_target_ms  % this->evals_to_target
+      % this->solution_size      % this->solution           % this->total_cost;
   ins();
 }
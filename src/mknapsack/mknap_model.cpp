@@ -3,9 +3,8 @@
 MknapModel::MknapModel() : db::BaseModel("mknap_executions") {}
 
 MknapModel::MknapModel(CLI *cli) : db::BaseModel("mknap_executions") {
-  this->crossover_id = cli->crossover_id;
+  this->set_crossover(cli->crossover);
   this->crossover_rate = cli->crossover_rate;
-  this->crossover_name = CrossoverFabric::name(this->crossover_id);
   this->mutation_rate = cli->mutation_rate;
   this->stop_criteria = cli->stop_criteria;
   this->population_size = cli->pop_size;
@@ -24,6 +23,18 @@ void MknapModel::create(sqlite::connection *con) {
   query += "instance_file TEXT, ";
   query += "convergence TEXT, ";
   query += "duration_in_ms REAL, ";
+  query += "phase_times TEXT, ";
+  query += "objective_calls INTEGER, ";
+  query += "repair_calls INTEGER, ";
+  query += "cache_hits INTEGER, ";
+  query += "local_search_moves INTEGER, ";
+  query += "operator_log TEXT, ";
+  query += "rates TEXT, ";
+  query += "restarts INTEGER, ";
+  query += "stop_rule TEXT, ";
+  query += "stop_reason TEXT, ";
+  query += "time_to_target_ms REAL, ";
+  query += "evals_to_target INTEGER, ";
   query += "num_items INTEGER, ";
   query += "solution TEXT, ";
   query += "total_costs REAL);";
@@ -34,6 +45,7 @@ void MknapModel::create(sqlite::connection *con) {
 # endif
 
   sqlite::execute(*con, query, true);
+  this->migrate(con);
 }
 
 void MknapModel::insert(sqlite::connection *con) {
@@ -41,8 +53,12 @@ void MknapModel::insert(sqlite::connection *con) {
   sql = "INSERT INTO " + std::string(this->table_name) + " (";
   sql += "population_size, stop_criteria, crossover, crossover_name, ";
   sql += "crossover_rate, mutation_rate, instance_file, convergence, ";
-  sql += "duration_in_ms, num_items, solution, total_costs";
-  sql += ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
+  sql += "duration_in_ms, phase_times, objective_calls, repair_calls, ";
+  sql += "cache_hits, local_search_moves, operator_log, rates, restarts, ";
+  sql += "stop_rule, stop_reason, time_to_target_ms, evals_to_target, ";
+  sql += "num_items, solution, total_costs";
+  sql += ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ";
+  sql += "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
 
 # ifdef NDEBUG
   std::cout << "Executando Query no banco:\n";
@@ -50,9 +66,13 @@ void MknapModel::insert(sqlite::connection *con) {
 # endif
 
   sqlite::execute ins(*con, sql);
-  ins % this->population_size % this->stop_criteria   % this->crossover_id
-      % this->crossover_name  % this->crossover_rate  % this->mutation_rate
-      % this->instance_file   % this->convergence     % this->duration_in_ms
-      % this->num_items       % this->solution        % this->total_costs;
+  ins % this->population_size    % this->stop_criteria      % this->crossover_id
+      % this->crossover_name     % this->crossover_rate     % this->mutation_rate
+      % this->instance_file      % this->convergence        % this->duration_in_ms
+      % this->phase_times        % this->objective_calls    % this->repair_calls
+      % this->cache_hits         % this->local_search_moves % this->operator_log
+      % this->rates              % this->restarts           % this->stop_rule
+      % this->stop_reason        % this->time_to_target_ms  % this->evals_to_target
+      % this->num_items          % this->solution           % this->total_costs;
   ins();
 }
@@ -65,11 +65,25 @@ MKnapsackProblem::MKnapsackProblem (const char *filename) {
         m_weights[i][j] = _values[ 3 + m_num_items + j + i*m_num_items ];
       }
     }
+    // Pesos de cada item contíguos, usados na avaliação incremental
+    m_item_weights = vector<float>(m_num_items * m_num_capacities);
+    for (uint i=0; i < m_num_capacities; i++) {
+      for (uint j=0; j < m_num_items; j++) {
+        m_item_weights[j*m_num_capacities + i] = m_weights[i][j];
+      }
+    }
     int _i = 3 + m_num_items + m_num_items*m_num_capacities;
     m_capacities = vector<float>(m_num_capacities);
     for (uint i=0; i < m_num_capacities; i++) {
       m_capacities[i] = _values[_i]; _i++;
     }
+
+    // Função 0 é o lucro e a função 1+i o consumo do recurso i
+    m_linear = LinearObjective(m_num_items);
+    m_linear.add(m_profits);
+    for (uint i=0; i < m_num_capacities; i++) {
+      m_linear.add(m_weights[i]);
+    }
   }
 }
 
@@ -88,13 +102,91 @@ eoPop<Chrom> MKnapsackProblem::init_pop(uint length, double bias) {
 
 void MKnapsackProblem::operator()(Chrom& chromosome_) {
   assert(chromosome_.size() == m_num_items);
-  
-  if (break_constraint(chromosome_)) {
-    chromosome_.fitness(0);
+
+  auto state = std::make_shared<KnapsackState>();
+  packed::pack(chromosome_, state->genes);
+
+  auto parent = dynamic_cast<const KnapsackState *>(chromosome_.evalState.get());
+  if (parent != nullptr and parent->genes.size() == state->genes.size()) {
+    this->delta_state(*state, *parent);
   } else {
-    auto f = sum_by_genes(m_profits.begin(), m_profits.end(),
-        chromosome_.cbegin(), chromosome_.cend());
-    chromosome_.fitness(f);
+    this->full_state(*state);
+  }
+
+  bool feasible = true;
+  for (size_t i=0; i < m_num_capacities; i++) {
+    if (state->loads[i] > m_capacities[i]) {
+      feasible = false;
+      break;
+    }
+  }
+  chromosome_.fitness(feasible ? state->profit : 0);
+  chromosome_.evalState = state;
+}
+
+
+void MKnapsackProblem::evaluate_batch(const PackedPopulation &pop,
+    const std::vector<size_t> &rows, std::vector<Fitness> &fitness) {
+  const size_t K = m_linear.size();
+  m_linear(pop, rows, m_sums);
+  fitness.resize(rows.size());
+  for (size_t r = 0; r < rows.size(); r++) {
+    const float *sums = &m_sums[r * K];
+    bool feasible = true;
+    for (size_t i=0; i < m_num_capacities; i++) {
+      if (sums[1 + i] > m_capacities[i]) {
+        feasible = false;
+        break;
+      }
+    }
+    fitness[r] = feasible ? sums[0] : 0;
+  }
+}
+
+
+void MKnapsackProblem::full_state(KnapsackState &state) {
+  state.profit = 0.0;
+  state.loads.assign(m_num_capacities, 0.0);
+  for (size_t w = 0; w < state.genes.size(); w++) {
+    for (packed::word_t bits = state.genes[w]; bits != 0; bits &= bits - 1) {
+      const size_t j = w * packed::WORD_BITS + __builtin_ctzll(bits);
+      const float *itemWeights = &m_item_weights[j * m_num_capacities];
+      state.profit += m_profits[j];
+      for (size_t i=0; i < m_num_capacities; i++) {
+        state.loads[i] += itemWeights[i];
+      }
+    }
+  }
+}
+
+
+void MKnapsackProblem::delta_state(KnapsackState &state, const KnapsackState &parent) {
+  // A soma completa percorre os itens selecionados; a incremental, os
+  // alterados. Usa a que tiver menos itens para visitar
+  size_t flips = 0, selected = 0;
+  for (size_t w = 0; w < state.genes.size(); w++) {
+    flips += __builtin_popcountll(state.genes[w] ^ parent.genes[w]);
+    selected += __builtin_popcountll(state.genes[w]);
+  }
+  if (flips >= selected) {
+    this->full_state(state);
+    return;
+  }
+
+  state.profit = parent.profit;
+  state.loads = parent.loads;
+  for (size_t w = 0; w < state.genes.size(); w++) {
+    const packed::word_t changed = state.genes[w] ^ parent.genes[w];
+    for (packed::word_t bits = changed; bits != 0; bits &= bits - 1) {
+      const unsigned b = __builtin_ctzll(bits);
+      const size_t j = w * packed::WORD_BITS + b;
+      const double sign = (state.genes[w] >> b) & 1 ? 1.0 : -1.0;
+      const float *itemWeights = &m_item_weights[j * m_num_capacities];
+      state.profit += sign * m_profits[j];
+      for (size_t i=0; i < m_num_capacities; i++) {
+        state.loads[i] += sign * itemWeights[i];
+      }
+    }
   }
 }
 
@@ -175,6 +267,11 @@ float MKnapsackProblem::optimal() {
   return this->m_optimal;
 }
 
+double MKnapsackProblem::known_optimum() {
+  if (this->m_optimal > 0) return this->m_optimal;
+  return Problem::known_optimum();
+}
+
 std::vector<float>& MKnapsackProblem::profits() {
   return this->m_profits;
 }
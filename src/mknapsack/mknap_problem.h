@@ -5,10 +5,23 @@
 #include <string>
 #include <core/ga/problem.h>
 #include <core/ga/random.h>
+#include <core/ga/packed_bits.h>
+#include <core/ga/linear_objective.h>
 #include <core/utils/split.h>
 #include <core/utils/vectors.h>
 // #include <scpxx/InstanceFile.h>
 
+/**
+ * Lucro e consumo de cada recurso de uma solução, anexados ao cromossomo
+ * avaliado. Guarda também os genes que descrevem para que a próxima
+ * avaliação descubra quais itens mudaram desde então. */
+struct KnapsackState : public EvaluationState {
+  std::vector<packed::word_t> genes;
+  double profit;
+  std::vector<double> loads;
+};
+
+
 class MKnapsackProblem : public Problem {
 public:
   using Problem::Fitness;
@@ -18,8 +31,28 @@ public:
 
   eoPop<Chrom> init_pop(uint length, double bias = 0.5);
 
+  /**
+   * Avalia o cromossomo. Se ele carrega o KnapsackState de uma avaliação
+   * anterior (dele ou do pai de quem foi copiado) e poucos genes mudaram
+   * desde então, somente os itens alterados são somados/subtraídos: O(m)
+   * por gene alterado em vez de O(m*n). */
   void operator()(Chrom &chromosome);
 
+  // A avaliação só lê a instância, então uma cópia pode avaliar em paralelo
+  Problem *clone_evaluator() const { return new MKnapsackProblem(*this); }
+
+  // O reparo só é usado na população inicial (repair_solution)
+  bool has_repair() const { return false; }
+
+  /**
+   * Avalia várias linhas de uma vez: lucro e consumos são somados em float
+   * por LinearObjective. Dá o mesmo fitness de operator() enquanto as somas
+   * são exatas em float (ex.: lucros e pesos inteiros com totais abaixo de
+   * 2^24, como nas instâncias da OR-Library). */
+  bool has_batch_evaluation() const { return true; }
+  void evaluate_batch(const PackedPopulation &pop,
+      const std::vector<size_t> &rows, std::vector<Fitness> &fitness);
+
   /**
    * Verifica se um indivíduo/cromossomo quebra alguma das restrições do
    * problema. */
@@ -31,6 +64,10 @@ public:
 
   std::vector<std::vector<float>> *weights();
   float optimal();
+
+  /**
+   * Ótimo informado no arquivo da instância (0 no arquivo = desconhecido) */
+  double known_optimum();
   std::vector<float>& capacities();
   std::vector<float>& profits();
 
@@ -39,6 +76,13 @@ private:
   float m_optimal;
   std::vector<float> m_capacities, m_profits;
   std::vector<std::vector<float>> m_weights;
+  std::vector<float> m_item_weights; // m_weights transposta (item x recurso)
+  LinearObjective m_linear;          // lucro e consumo de cada recurso
+  std::vector<float> m_sums;
+
+  // Avaliação completa e incremental do estado de uma solução
+  void full_state(KnapsackState &state);
+  void delta_state(KnapsackState &state, const KnapsackState &parent);
 
   // Função para verifica se alguma restrição foi quebrada
   bool resources_is_greater(const std::vector<float>* resources);
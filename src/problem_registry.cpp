@@ -0,0 +1,87 @@
+#include "problem_registry.h"
+#include <stdexcept>
+
+#include "maxclique/maximum_weighted_clique_problem.h"
+#include "maxclique/mcp_database.hpp"
+#include "mknapsack/mknap_problem.h"
+#include "mknapsack/mknap_model.h"
+#include "setcovering/set_covering_problem.h"
+#include "setcovering/scp_model.h"
+#include "steinertree/steiner_tree.h"
+#include "steinertree/steiner_tree_model.h"
+
+std::map<std::string, ProblemRegistry::Entry> &ProblemRegistry::registry() {
+  static std::map<std::string, Entry> entries = {
+    {"maxclique", {"Clique de peso máximo (DIMACS-W ou .mtx)",
+      [](const char *infile) -> ProblemSession * {
+        using R = Runner<MWCProblem, MCPModel>;
+        return new RunnerSession<MWCProblem, MCPModel>(infile,
+            [](R &r, MCPModel &model) {
+              model.solution_size = r.get_solution_size();
+              model.solution = r.get_formatted_solution();
+              model.total_cost = r.get_solution_total_cost();
+            });
+      }}},
+    {"mknapsack", {"Mochila multidimensional (OR-Library mknapcb)",
+      [](const char *infile) -> ProblemSession * {
+        using R = Runner<MKnapsackProblem, MknapModel>;
+        return new RunnerSession<MKnapsackProblem, MknapModel>(infile,
+            [](R &r, MknapModel &model) {
+              model.num_items = r.get_solution_size();
+              model.solution = r.get_formatted_solution();
+              model.total_costs = r.get_solution_total_cost();
+            });
+      }}},
+    {"setcovering", {"Cobertura de conjuntos (OR-Library scp)",
+      [](const char *infile) -> ProblemSession * {
+        using R = Runner<SetCoveringProblem, SCPModel>;
+        return new RunnerSession<SetCoveringProblem, SCPModel>(infile,
+            [](R &r, SCPModel &model) {
+              model.num_columns = r.get_solution_size();
+              model.columns = r.get_formatted_solution();
+              model.total_costs = r.get_solution_total_cost();
+            });
+      }}},
+    {"steinertree", {"Árvore de Steiner em grafos (OR-Library steinb..e)",
+      [](const char *infile) -> ProblemSession * {
+        using R = Runner<SteinerTreeProblem, SteinerTreeModel>;
+        return new RunnerSession<SteinerTreeProblem, SteinerTreeModel>(infile,
+            [](R &r, SteinerTreeModel &model) {
+              model.set_solution_data(r.get_problem(), r.get_best_solution());
+              model.total_costs = r.get_solution_total_cost();
+            });
+      }}},
+  };
+  return entries;
+}
+
+void ProblemRegistry::add(const std::string &name,
+    const std::string &description, Creator creator) {
+  registry()[name] = Entry{description, std::move(creator)};
+}
+
+bool ProblemRegistry::has(const std::string &name) {
+  return registry().count(name) > 0;
+}
+
+std::vector<std::pair<std::string, std::string>> ProblemRegistry::list() {
+  std::vector<std::pair<std::string, std::string>> names;
+  for (const auto &entry : registry()) {
+    names.emplace_back(entry.first, entry.second.description);
+  }
+  return names;
+}
+
+ProblemSession *ProblemRegistry::create(const std::string &name,
+    const char *infile) {
+  auto it = registry().find(name);
+  if (it == registry().end()) {
+    std::string available;
+    for (const auto &entry : registry()) {
+      available += " " + entry.first;
+    }
+    throw std::invalid_argument("Problema desconhecido: " + name
+        + ". Disponíveis:" + available);
+  }
+  return it->second.creator(infile);
+}
@@ -0,0 +1,102 @@
+#ifndef PROBLEM_REGISTRY_H_
+#define PROBLEM_REGISTRY_H_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <core/cli/options.h>
+#include <core/db/database.hpp>
+#include <core/ga/problem.h>
+#include "Runner.h"
+
+/**
+ * @class ProblemSession
+ * Instância carregada de um problema qualquer. Pode ser executada várias
+ * vezes, cada execução com um Runner novo, sem ler o arquivo de novo.
+ */
+class ProblemSession {
+public:
+  virtual ~ProblemSession() = default;
+
+  /**
+   * Executa o AG com os argumentos e grava a execução no banco de dados se
+   * -d foi informado. O pré-processamento (-P) e o decodificador (-D) só são
+   * aplicados na primeira execução */
+  virtual void run(CLI *args) = 0;
+
+  virtual Problem &get_problem() = 0;
+};
+
+/**
+ * @class RunnerSession
+ * ProblemSession de um Runner<ConcreteProblem, DbModel>. `fill` completa o
+ * modelo com as colunas da solução, que são diferentes em cada problema.
+ */
+template <class ConcreteProblem, class DbModel>
+class RunnerSession : public ProblemSession {
+public:
+  using Filler = std::function<void(Runner<ConcreteProblem, DbModel> &, DbModel &)>;
+
+  RunnerSession(const char *infile, Filler fill_)
+    : instance(new ConcreteProblem(infile)), fill(std::move(fill_)) {}
+
+  void run(CLI *args) override {
+    Runner<ConcreteProblem, DbModel> runner(this->instance.get(), this->prepared);
+    runner(args);
+    this->prepared = true;
+
+    if (args->using_db) {
+      DbModel model = runner.get_model();
+      this->fill(runner, model);
+      db::Database db(args->databasefile);
+      db.set_model(&model);
+      db.exec_insertion();
+    }
+  }
+
+  Problem &get_problem() override { return *this->instance; }
+
+private:
+  std::unique_ptr<ConcreteProblem> instance;
+  Filler fill;
+  bool prepared = false;
+};
+
+/**
+ * Registro dos problemas por nome, usado pelo executável crossover-study.
+ * Os quatro problemas do estudo (maxclique, mknapsack, setcovering e
+ * steinertree) são registrados na primeira utilização.
+ */
+class ProblemRegistry {
+public:
+  using Creator = std::function<ProblemSession *(const char *infile)>;
+
+  /**
+   * Registra (ou substitui) o problema `name` */
+  static void add(const std::string &name, const std::string &description,
+      Creator creator);
+
+  static bool has(const std::string &name);
+
+  /**
+   * Nomes e descrições dos problemas registrados */
+  static std::vector<std::pair<std::string, std::string>> list();
+
+  /**
+   * Carrega a instância `infile` do problema `name`. O chamador é o dono do
+   * objeto */
+  static ProblemSession *create(const std::string &name, const char *infile);
+
+private:
+  struct Entry {
+    std::string description;
+    Creator creator;
+  };
+
+  static std::map<std::string, Entry> &registry();
+};
+
+#endif // PROBLEM_REGISTRY_H_
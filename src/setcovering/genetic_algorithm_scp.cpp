@@ -11,14 +11,19 @@ void scp::GeneticAlgorithmSCP::operator()(eoPop<Chrom>& population,
 	convergence.clear();
 
 	auto start_evo = std::chrono::system_clock::now();
+	phaseTimer.reset();
 
 	// Loop principal da evolução
 	do {
 		gen++;
+		phaseTimer.start();
 		// Salva o mlehor indivíduo atual
 		_elite = population.best_element();
+		phaseTimer.lap(PhaseTimer::elitism);
+
 		// Seleção para a próxima geração
 		select(population, nextgen);
+		phaseTimer.lap(PhaseTimer::selection);
 
 		// Aplicação da operação de cruzamento / crossover
 		for (size_t i=0; i < (population.size()/2); i++) {
@@ -28,6 +33,7 @@ void scp::GeneticAlgorithmSCP::operator()(eoPop<Chrom>& population,
 				}
 			}
 		}
+		phaseTimer.lap(PhaseTimer::crossover);
 
 		// Aplicação do operador de mutação
 		for (size_t i=0; i < nextgen.size(); i++) {
@@ -36,20 +42,32 @@ void scp::GeneticAlgorithmSCP::operator()(eoPop<Chrom>& population,
 					nextgen[i].invalidate();
 			}
 		}
+		phaseTimer.lap(PhaseTimer::mutation);
 
     // Aplica o operador de factibilidade nos cromossomos recém-gerados
     for (size_t i=0; i < nextgen.size(); i++) {
-      scp_instance.make_feasible(nextgen[i]);
+      evaluator.repair(nextgen[i]);
     }
-		// Aplica avaliação a nova geração
-		scp_instance.eval(nextgen);
+		phaseTimer.lap(PhaseTimer::repair);
+
+		// Aplica avaliação a nova geração. Se o orçamento de avaliações acabar
+		// no meio da geração, os filhos restantes são descartados e mantém-se
+		// os indivíduos da população atual
+		for (size_t i=0; i < nextgen.size(); i++) {
+			evaluator.evaluate(nextgen[i]);
+			if (nextgen[i].invalid()) {
+				nextgen[i] = population[i];
+			}
+		}
 		population.swap(nextgen);
+		phaseTimer.lap(PhaseTimer::evaluation);
 
 		// Recupera o elite
 		auto _worseIt = population.it_worse_element();
 		*_worseIt = _elite;
 
 		convergence.push_back( population.best_element() );
+		phaseTimer.lap(PhaseTimer::elitism);
 		callback_function(gen, population);
 
 	} while (stopCriteria(population));
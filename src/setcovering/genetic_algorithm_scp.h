@@ -9,6 +9,8 @@ using std::chrono::system_clock;
 
 #include <core/ga/genetic_algorithm.h>
 #include <core/ga/problem.h>
+#include <core/ga/phase_timer.h>
+#include <core/ga/evaluation_counter.h>
 #include "set_covering_problem.h"
 
 namespace scp {
@@ -20,14 +22,14 @@ namespace scp {
 
     // Default constructor
     explicit GeneticAlgorithmSCP(
-        SetCoveringProblem &problem_,
+        EvaluationCounter &evaluator_,
         eoSelectOne<Chrom> &selectOp_,
         eoQuadOp<Chrom> &crossoverOp_,
         const float crossoverRate_,
         eoMonOp<Chrom> &mutationOp_,
         const float mutationRate_,
         eoContinue<Chrom> &continue_
-    ) : scp_instance(problem_),
+    ) : evaluator(evaluator_),
       select(selectOp_),
       cross(crossoverOp_),
       mutate(mutationOp_),
@@ -50,8 +52,12 @@ namespace scp {
       return this->evolution_time;
     }
 
+    const PhaseTimer& phase_timer() const {
+      return this->phaseTimer;
+    }
+
   protected:
-    SetCoveringProblem& scp_instance;
+    EvaluationCounter& evaluator; // Avaliador com reparo da SetCoveringProblem
     eoSelectPerc<Chrom> select;
     eoInvalidateQuadOp<Chrom> cross;
     eoInvalidateMonOp<Chrom> mutate;
@@ -59,6 +65,7 @@ namespace scp {
     float crossoverRate;
     float mutationRate;
     nanoseconds evolution_time;
+    PhaseTimer phaseTimer;
   };
 
 }
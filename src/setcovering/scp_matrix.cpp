@@ -1,5 +1,7 @@
 #include "scp_matrix.h"
 
+namespace scp {
+
 
 std::vector<std::string> scp_split(const std::string &txt) {
   std::vector<std::string> result;
@@ -130,3 +132,5 @@ std::ostream& operator<<(std::ostream &os, matrix &m) {
   }
   return os;
 }
+
+} // namespace scp
@@ -10,7 +10,7 @@
 #define ASSERT_THROW(expr, onFailedMsg) \
   if ((expr) == false) throw std::runtime_error(onFailedMsg)
 
-// namespace scp {
+namespace scp {
   struct matrix {
     size_t num_rows, num_columns;
 
@@ -37,6 +37,6 @@
     bool *values;
     float *weights;
   };
-// }
+}
 
 #endif
\ No newline at end of file
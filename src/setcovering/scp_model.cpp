@@ -8,9 +8,8 @@ SCPModel::SCPModel(CLI *cli)
 : db::BaseModel("setcovering_executions"), num_columns(0), 
   columns(std::string()), total_costs(0.0f)
 {
-  this->crossover_id = cli->crossover_id;
+  this->set_crossover(cli->crossover);
   this->crossover_rate = cli->crossover_rate;
-  this->crossover_name = CrossoverFabric::name(this->crossover_id);
   this->mutation_rate = cli->mutation_rate;
   this->stop_criteria = cli->stop_criteria;
   this->population_size = cli->pop_size;
@@ -29,6 +28,18 @@ void SCPModel::create(sqlite::connection *con) {
   query += "instance_file TEXT, ";
   query += "convergence TEXT, ";
   query += "duration_in_ms REAL, ";
+  query += "phase_times TEXT, ";
+  query += "objective_calls INTEGER, ";
+  query += "repair_calls INTEGER, ";
+  query += "cache_hits INTEGER, ";
+  query += "local_search_moves INTEGER, ";
+  query += "operator_log TEXT, ";
+  query += "rates TEXT, ";
+  query += "restarts INTEGER, ";
+  query += "stop_rule TEXT, ";
+  query += "stop_reason TEXT, ";
+  query += "time_to_target_ms REAL, ";
+  query += "evals_to_target INTEGER, ";
   query += "num_columns INTEGER, ";
   query += "columns TEXT, ";
   query += "total_costs REAL);";
@@ -38,6 +49,7 @@ void SCPModel::create(sqlite::connection *con) {
   std::cout << query << std::endl;
 # endif
   sqlite::execute(*con, query, true);
+  this->migrate(con);
 }
 
 void SCPModel::insert(sqlite::connection *con) {
@@ -45,8 +57,12 @@ void SCPModel::insert(sqlite::connection *con) {
   sql = "INSERT INTO " + std::string(this->table_name) + " (";
   sql += "population_size, stop_criteria, crossover, crossover_name, ";
   sql += "crossover_rate, mutation_rate, instance_file, convergence, ";
-  sql += "duration_in_ms, num_columns, columns, total_costs";
-  sql += ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
+  sql += "duration_in_ms, phase_times, objective_calls, repair_calls, ";
+  sql += "cache_hits, local_search_moves, operator_log, rates, restarts, ";
+  sql += "stop_rule, stop_reason, time_to_target_ms, evals_to_target, ";
+  sql += "num_columns, columns, total_costs";
+  sql += ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ";
+  sql += "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
 
 # ifdef NDEBUG
   std::cout << "Executando Query no banco:\n";
@@ -54,9 +70,13 @@ void SCPModel::insert(sqlite::connection *con) {
 # endif
 
   sqlite::execute ins(*con, sql);
-  ins % this->population_size % this->stop_criteria   % this->crossover_id
-      % this->crossover_name  % this->crossover_rate  % this->mutation_rate
-      % this->instance_file   % this->convergence     % this->duration_in_ms
-      % this->num_columns     % this->columns         % this->total_costs;
+  ins % this->population_size    % this->stop_criteria      % this->crossover_id
+      % this->crossover_name     % this->crossover_rate     % this->mutation_rate
+      % this->instance_file      % this->convergence        % this->duration_in_ms
+      % this->phase_times        % this->objective_calls    % this->repair_calls
+      % this->cache_hits         % this->local_search_moves % this->operator_log
+      % this->rates              % this->restarts           % this->stop_rule
+      % this->stop_reason        % this->time_to_target_ms  % this->evals_to_target
+      % this->num_columns        % this->columns            % this->total_costs;
   ins();
 }
@@ -6,7 +6,7 @@ SetCoveringProblem::SetCoveringProblem(const char *filename) {
 
   std::ifstream file(filename);
   if (file.is_open()) {
-    this->coverage_matrix = new matrix(file);
+    this->coverage_matrix = new scp::matrix(file);
     this->chromSize = this->coverage_matrix->num_columns;
     this->num_subsets = this->coverage_matrix->num_columns;
     this->num_elements = this->coverage_matrix->num_rows;
@@ -18,18 +18,22 @@ SetCoveringProblem::SetCoveringProblem(const char *filename) {
 
     // Alimeta os vectores de colunas que cobrem cada linha e linhas cobertas
     // por cada coluna
-    this->columns_that_covers = std::vector< std::set<unsigned int> >(this->num_elements);
-    this->rows_covered_by = std::vector< std::set<unsigned int> >(this->num_subsets);
+    auto index = std::make_shared<SCPCoverage>();
+    index->columns_that_covers = std::vector< std::set<unsigned int> >(this->num_elements);
+    index->rows_covered_by = std::vector< std::set<unsigned int> >(this->num_subsets);
 
     for (size_t row = 0; row < this->num_elements; row++) {
       for (size_t col = 0; col < this->num_subsets; col++) {
         if (this->coverage_matrix->get(row, col)) {
-          this->columns_that_covers[row].insert(col);
-          this->rows_covered_by[col].insert(row);
+          index->columns_that_covers[row].insert(col);
+          index->rows_covered_by[col].insert(row);
         }
       }
     }
+    this->index = index;
 
+    this->cost = LinearObjective(this->num_subsets);
+    this->cost.add(std::vector<float>(this->weights, this->weights + this->num_subsets));
   } else {
     std::cerr << "Use a opção -f" << std::endl;
     throw std::runtime_error(
@@ -46,7 +50,7 @@ SetCoveringProblem::~SetCoveringProblem() {
 
 // Métodos herdados de "Problem"
 
-matrix* SetCoveringProblem::get_matrix() {
+scp::matrix* SetCoveringProblem::get_matrix() {
   return this->coverage_matrix;
 }
 
@@ -83,14 +87,25 @@ SetCoveringProblem::init_pop(unsigned int length, double bias) {
 }
 
 
+const std::set<unsigned int>&
+SetCoveringProblem::columns_covering(size_t row) const {
+  return this->index->columns_that_covers[row];
+}
+
+const std::set<unsigned int>&
+SetCoveringProblem::rows_covered(size_t column) const {
+  return this->index->rows_covered_by[column];
+}
+
+
 std::set<uint> SetCoveringProblem::coverage_set(const Chrom& chrom) {
   // Constrói um set com todas as linhas cobertas pela definição do cromossomo
   std::set<uint> l_rows_covered;
   for (size_t k=0; k < this->chromSize; k++) {
     if (chrom[k]) {
       l_rows_covered.insert(
-        this->rows_covered_by[k].begin(),
-        this->rows_covered_by[k].end()
+        this->index->rows_covered_by[k].begin(),
+        this->index->rows_covered_by[k].end()
       );
     }
   }
@@ -102,7 +117,8 @@ bool SetCoveringProblem::atend_constraint(const Chrom& chrom) {
   std::set<unsigned int> coverage;
   for (size_t i=0; i < chrom.size(); i++) {
     if (chrom[i]) {
-      coverage.insert(rows_covered_by[i].begin(), rows_covered_by[i].end());
+      coverage.insert(this->index->rows_covered_by[i].begin(),
+                      this->index->rows_covered_by[i].end());
     }
   }
   return (coverage.size() == this->num_elements);
@@ -122,14 +138,19 @@ void SetCoveringProblem::make_feasible(Chrom& chrom) {
 
     for (auto iter = diff.begin(); iter != diff.end(); ++iter) {
       uint uncovered_row = *iter;
-      if (!chrom[*this->columns_that_covers[uncovered_row].begin()]) {
-        chrom[*this->columns_that_covers[uncovered_row].begin()] = true;
+      if (!chrom[*this->index->columns_that_covers[uncovered_row].begin()]) {
+        chrom[*this->index->columns_that_covers[uncovered_row].begin()] = true;
       }
     }
   }
 }
 
 
+void SetCoveringProblem::repair(Chrom& chrom) {
+  this->make_feasible(chrom);
+}
+
+
 // Função objetivo da cobertura de conjuntos
 void SetCoveringProblem::operator()(Chrom& chrom) {
   if (!this->atend_constraint(chrom)) {
@@ -144,3 +165,212 @@ void SetCoveringProblem::operator()(Chrom& chrom) {
   }
   chrom.fitness(1/accum);
 }
+
+
+// Mesmo fitness de operator(): as somas de LinearObjective também são em
+// float e na ordem das colunas
+void SetCoveringProblem::evaluate_batch(const PackedPopulation &pop,
+    const std::vector<size_t> &rows, std::vector<Fitness> &fitness) {
+  this->cost(pop, rows, this->costSums);
+  fitness.resize(rows.size());
+  for (size_t r = 0; r < rows.size(); r++) {
+    fitness[r] = 1 / this->costSums[r];
+  }
+}
+
+
+void SetCoveringProblem::register_crossovers() {
+  CrossoverFabric::add("coverage",
+      "Preserva a cobertura: colunas comuns + colunas dos pais para cada linha",
+      // Captura só o índice de cobertura, que vive enquanto houver operador
+      [index = this->index](const CrossoverSpec &spec) -> eoQuadOp<Chrom>* {
+        spec.check_params({});
+        return new CoverageCrossover(index);
+      });
+}
+
+
+CoverageCrossover::CoverageCrossover(std::shared_ptr<const SCPCoverage> index)
+  : index(std::move(index)), coverCount(this->index->columns_that_covers.size()),
+    rowOrder(this->index->columns_that_covers.size()) {
+  std::iota(this->rowOrder.begin(), this->rowOrder.end(), 0);
+}
+
+bool CoverageCrossover::operator()(Chrom &chrom1, Chrom &chrom2) {
+  this->parent1 = chrom1;
+  this->parent2 = chrom2;
+  this->make_child(this->parent1, this->parent2, chrom1);
+  this->make_child(this->parent2, this->parent1, chrom2);
+  return chrom1 != this->parent1 or chrom2 != this->parent2;
+}
+
+void CoverageCrossover::make_child(const Chrom &first, const Chrom &second,
+    Chrom &child) {
+  std::fill(this->coverCount.begin(), this->coverCount.end(), 0);
+  for (size_t col = 0; col < child.size(); col++) {
+    child[col] = first[col] and second[col];
+    if (child[col]) {
+      for (unsigned int row : this->index->rows_covered_by[col]) {
+        this->coverCount[row]++;
+      }
+    }
+  }
+
+  // Linhas em ordem aleatória para não favorecer as primeiras colunas
+  for (size_t i = this->rowOrder.size(); i > 1; i--) {
+    std::swap(this->rowOrder[i - 1], this->rowOrder[rng.random(i)]);
+  }
+
+  for (unsigned int row : this->rowOrder) {
+    if (this->coverCount[row] > 0) continue;
+
+    // Sorteia (reservoir sampling) uma coluna do pai principal que cubra a
+    // linha; se ele não tiver nenhuma, uma do outro pai
+    long chosen = -1;
+    for (const Chrom *parent : {&first, &second}) {
+      unsigned int seen = 0;
+      for (unsigned int col : this->index->columns_that_covers[row]) {
+        if ((*parent)[col] and rng.random(++seen) == 0) {
+          chosen = col;
+        }
+      }
+      if (chosen >= 0) break;
+    }
+    // Nenhum dos pais cobre a linha: o reparo cuida dela depois
+    if (chosen < 0) continue;
+
+    child[chosen] = true;
+    for (unsigned int r : this->index->rows_covered_by[chosen]) {
+      this->coverCount[r]++;
+    }
+  }
+}
+
+
+LocalSearch *SetCoveringProblem::create_local_search() {
+  return new SCPLocalSearch(*this);
+}
+
+
+SCPLocalSearch::SCPLocalSearch(const SetCoveringProblem &problem)
+  : problem(problem), coverCount(problem.get_num_elements()),
+    rowMark(problem.get_num_elements()) {}
+
+void SCPLocalSearch::add(Chrom &chrom, unsigned int column) {
+  chrom[column] = true;
+  for (unsigned int row : this->problem.rows_covered(column)) {
+    this->coverCount[row]++;
+  }
+}
+
+void SCPLocalSearch::remove(Chrom &chrom, unsigned int column) {
+  chrom[column] = false;
+  for (unsigned int row : this->problem.rows_covered(column)) {
+    this->coverCount[row]--;
+  }
+}
+
+bool SCPLocalSearch::redundant(unsigned int column) const {
+  for (unsigned int row : this->problem.rows_covered(column)) {
+    if (this->coverCount[row] < 2) return false;
+  }
+  return true;
+}
+
+bool SCPLocalSearch::drop_redundant(Chrom &chrom) {
+  bool changed = false;
+  for (unsigned int column : this->columns) {
+    if (!chrom[column]) continue;
+    if (!this->spend()) break;
+    if (this->redundant(column)) {
+      this->remove(chrom, column);
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+bool SCPLocalSearch::swap_out(Chrom &chrom, unsigned int j) {
+  // Linhas que ficariam descobertas sem j
+  this->rowStamp++;
+  unsigned int uncovered = 0, first = 0;
+  for (unsigned int row : this->problem.rows_covered(j)) {
+    if (this->coverCount[row] == 1) {
+      if (uncovered++ == 0) first = row;
+      this->rowMark[row] = this->rowStamp;
+    }
+  }
+  if (uncovered == 0) {
+    this->remove(chrom, j);
+    return true;
+  }
+
+  const float wj = this->problem.get_weight(j);
+  for (unsigned int k : this->problem.columns_covering(first)) {
+    if (chrom[k]) continue;
+    if (!this->spend()) return false;
+
+    unsigned int covers = 0;
+    for (unsigned int row : this->problem.rows_covered(k)) {
+      covers += this->rowMark[row] == this->rowStamp;
+    }
+    if (covers < uncovered) continue;
+
+    const float wk = this->problem.get_weight(k);
+    this->add(chrom, k);
+    this->remove(chrom, j);
+    if (wk < wj) return true;
+
+    // Troca 2-1: uma coluna que k tornou redundante e paga a diferença
+    this->colStamp++;
+    for (unsigned int row : this->problem.rows_covered(k)) {
+      for (unsigned int j2 : this->problem.columns_covering(row)) {
+        if (j2 == k or !chrom[j2] or this->colMark[j2] == this->colStamp) continue;
+        this->colMark[j2] = this->colStamp;
+        if (!this->spend()) break;
+        if (wj + this->problem.get_weight(j2) > wk and this->redundant(j2)) {
+          this->remove(chrom, j2);
+          return true;
+        }
+      }
+    }
+    // Sem parceira: desfaz a troca e tenta a próxima coluna que cobre as
+    // linhas de j
+    this->add(chrom, j);
+    this->remove(chrom, k);
+  }
+  return false;
+}
+
+bool SCPLocalSearch::search(Chrom &chrom) {
+  if (this->colMark.size() != chrom.size()) {
+    this->colMark.assign(chrom.size(), 0);
+  }
+  std::fill(this->coverCount.begin(), this->coverCount.end(), 0);
+  this->columns.clear();
+  for (size_t col = 0; col < chrom.size(); col++) {
+    if (chrom[col]) {
+      this->columns.push_back(col);
+      for (unsigned int row : this->problem.rows_covered(col)) {
+        this->coverCount[row]++;
+      }
+    }
+  }
+  std::sort(this->columns.begin(), this->columns.end(),
+      [this](unsigned int a, unsigned int b) {
+        return this->problem.get_weight(a) > this->problem.get_weight(b);
+      });
+
+  bool changed = this->drop_redundant(chrom);
+  bool swapped = false;
+  for (unsigned int j : this->columns) {
+    if (!chrom[j]) continue;
+    if (!this->spend()) break;
+    swapped = this->swap_out(chrom, j) or swapped;
+  }
+  // As colunas que entraram nas trocas podem ter deixado outras redundantes
+  if (swapped) {
+    this->drop_redundant(chrom);
+  }
+  return changed or swapped;
+}
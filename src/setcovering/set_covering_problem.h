@@ -5,12 +5,16 @@
 
 #include <vector>
 #include <set>
+#include <memory>
 #include <cstdio>
 #include <fstream>
 #include <numeric>
 #include <algorithm>
 #include <core/ga/problem.h>
 #include <core/ga/random.h>
+#include <core/ga/crossover_fabric.h>
+#include <core/ga/local_search.h>
+#include <core/ga/linear_objective.h>
 #include <core/utils/split.h>
 #include <core/utils/vectors.h>
 #include "scp_matrix.h"
@@ -18,6 +22,17 @@
 #define LOG_DBG(message) std::cout << "[" << __func__ << "] " << message << std::endl
 
 
+/**
+ * Colunas que cobrem cada linha e linhas cobertas por cada coluna. Não muda
+ * depois de construído, então é compartilhado com os operadores registrados
+ * (CoverageCrossover), que continuam válidos mesmo após destruir o problema
+ */
+struct SCPCoverage {
+  std::vector< std::set<unsigned int> > columns_that_covers; // Colunas que cobrem cada linha
+  std::vector< std::set<unsigned int> > rows_covered_by; // Linhas sendo cobertas para cada coluna
+};
+
+
 /**
  * Classe para o Problema da Cobertura de Conjuntos
  */
@@ -35,6 +50,20 @@ public:
 
   void operator()(Chrom &chromosome);
 
+  // O reparo da cobertura de conjuntos é o operador de factibilidade
+  void repair(Chrom &chromosome);
+
+  // Custo das linhas reparadas pela soma dos pesos em lote (LinearObjective)
+  bool has_batch_evaluation() const { return true; }
+  void evaluate_batch(const PackedPopulation &pop,
+      const std::vector<size_t> &rows, std::vector<Fitness> &fitness);
+
+  // Registra o crossover "coverage" (CoverageCrossover)
+  void register_crossovers();
+
+  // Busca local por remoção e troca de colunas (SCPLocalSearch)
+  LocalSearch *create_local_search();
+
   // Verifica se um cromossomo atende às restrições da instância do problema
   bool atend_constraint(const Chrom& chrom);
 
@@ -48,19 +77,26 @@ public:
   // Métodos relacionados à manipulação da matriz
 
   // Retorna um ponteiro para a matriz booleana
-  matrix* get_matrix();
+  scp::matrix* get_matrix();
 
   // Retorna um ponteiro para o array de pesos das colunas
   float* get_weights();
+  float get_weight(size_t column) const { return this->weights[column]; }
+
+  // Colunas que cobrem uma linha e linhas cobertas por uma coluna
+  const std::set<unsigned int>& columns_covering(size_t row) const;
+  const std::set<unsigned int>& rows_covered(size_t column) const;
+  size_t get_num_elements() const { return this->num_elements; }
 
 private:
   size_t num_elements;     // Número de linhas na matriz
   size_t num_subsets;      // Número de colunas na matriz
-  matrix *coverage_matrix; // Matriz de cobertura
+  scp::matrix *coverage_matrix; // Matriz de cobertura
   float *weights;          // Pesos das colunas
-  std::vector< std::set<unsigned int> > columns_that_covers; // Colunas que cobrem cada linha
-  std::vector< std::set<unsigned int> > rows_covered_by; // Linhas sendo cobertas para cada coluna
+  std::shared_ptr<const SCPCoverage> index; // Colunas por linha e linhas por coluna
   std::set<unsigned int> all_elements; // Conjunto de todas os elementos (linhas)
+  LinearObjective cost;    // Soma dos pesos das colunas escolhidas
+  std::vector<float> costSums;
 
   /**
    * Retorna um conjunto (set) de linhas que estão sendo cobertas pela solução
@@ -68,4 +104,72 @@ private:
   std::set<unsigned int> coverage_set(const Chrom &chrom);
 };
 
+
+/**
+ * Crossover que preserva a cobertura: cada filho começa com as colunas comuns
+ * aos dois pais e, para cada linha ainda descoberta (em ordem aleatória),
+ * recebe uma coluna dos pais que a cubra, preferindo o seu pai principal.
+ * Filhos de pais factíveis são sempre factíveis.
+ */
+class CoverageCrossover : public eoQuadOp<Chrom> {
+public:
+  explicit CoverageCrossover(std::shared_ptr<const SCPCoverage> index);
+
+  bool operator()(Chrom &chrom1, Chrom &chrom2);
+
+  std::string className() const { return "CoverageCrossover"; }
+
+private:
+  std::shared_ptr<const SCPCoverage> index;
+  Chrom parent1, parent2;
+  std::vector<unsigned int> coverCount; // colunas do filho cobrindo cada linha
+  std::vector<unsigned int> rowOrder;
+
+  void make_child(const Chrom &first, const Chrom &second, Chrom &child);
+};
+
+
+/**
+ * Busca local da cobertura de conjuntos sobre a contagem de colunas que
+ * cobrem cada linha, então cada movimento custa O(linhas da coluna):
+ *
+ *  - remoção: tira uma coluna redundante (todas as suas linhas são cobertas
+ *    por outra coluna);
+ *  - troca 1-1: tira a coluna j e põe uma coluna k mais barata que cobre
+ *    todas as linhas que só j cobria;
+ *  - troca 2-1: se k não é mais barata que j, procura uma segunda coluna
+ *    que fica redundante com k e cujo peso somado ao de j supera o de k.
+ *
+ * As colunas são examinadas da mais cara para a mais barata, aceitando a
+ * primeira melhora. O cromossomo de entrada deve ser factível.
+ */
+class SCPLocalSearch : public LocalSearch {
+public:
+  explicit SCPLocalSearch(const SetCoveringProblem &problem);
+
+  std::string className() const { return "SCPLocalSearch"; }
+
+protected:
+  bool search(Chrom &chrom);
+
+private:
+  const SetCoveringProblem &problem;
+  std::vector<unsigned int> coverCount; // colunas selecionadas cobrindo cada linha
+  std::vector<unsigned int> rowMark;    // linhas só cobertas pela coluna removida
+  std::vector<unsigned int> colMark;    // colunas já examinadas na troca 2-1
+  unsigned int rowStamp = 0;            // marca atual de rowMark
+  unsigned int colStamp = 0;            // marca atual de colMark
+  std::vector<unsigned int> columns;
+
+  void add(Chrom &chrom, unsigned int column);
+  void remove(Chrom &chrom, unsigned int column);
+  bool redundant(unsigned int column) const;
+
+  // Tenta trocar a coluna j (troca 1-1 ou 2-1); true se trocou
+  bool swap_out(Chrom &chrom, unsigned int j);
+
+  // Remove as colunas redundantes, das mais caras para as mais baratas
+  bool drop_redundant(Chrom &chrom);
+};
+
 #endif
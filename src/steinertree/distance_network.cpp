@@ -0,0 +1,196 @@
+#include "distance_network.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <utility>
+
+namespace steiner {
+
+CSRGraph::CSRGraph(const Instance &instance)
+  : offsets(instance.num_nodes + 1, 0) {
+  for (const edge_t &edge : instance.edges) {
+    this->offsets[edge.first + 1]++;
+    this->offsets[edge.second + 1]++;
+  }
+  for (size_t v = 0; v < instance.num_nodes; v++) {
+    this->offsets[v + 1] += this->offsets[v];
+  }
+  this->targets.resize(this->offsets.back());
+  this->edge_ids.resize(this->offsets.back());
+  this->weights.resize(this->offsets.back());
+
+  std::vector<uint32_t> next(this->offsets.begin(), this->offsets.end() - 1);
+  for (size_t e = 0; e < instance.edges.size(); e++) {
+    const edge_t &edge = instance.edges[e];
+    for (auto [u, v] : {edge, edge_t(edge.second, edge.first)}) {
+      const uint32_t i = next[u]++;
+      this->targets[i] = uint32_t(v);
+      this->edge_ids[i] = uint32_t(e);
+      this->weights[i] = instance.weights[e];
+    }
+  }
+}
+
+DistanceNetwork::DistanceNetwork(const Instance &instance)
+  : n(instance.num_nodes), edges(instance.edges), weights(instance.weights),
+    terminal(instance.terminal),
+    mst(instance.num_nodes, instance.edges, instance.weights),
+    dist(n * n, INFINITY), via(n * n, -1) {
+  auto start = std::chrono::steady_clock::now();
+  const CSRGraph graph(instance);
+
+  using item = std::pair<float, uint32_t>;
+  std::priority_queue<item, std::vector<item>, std::greater<item>> heap;
+  for (size_t source = 0; source < this->n; source++) {
+    float *row = &this->dist[source * this->n];
+    int32_t *edge = &this->via[source * this->n];
+    row[source] = 0;
+    heap.push(item(0, uint32_t(source)));
+    while (!heap.empty()) {
+      auto [d, u] = heap.top();
+      heap.pop();
+      if (d > row[u]) continue;
+      for (uint32_t i = graph.offsets[u]; i < graph.offsets[u + 1]; i++) {
+        const uint32_t v = graph.targets[i];
+        const float dv = d + graph.weights[i];
+        if (dv < row[v]) {
+          row[v] = dv;
+          edge[v] = int32_t(graph.edge_ids[i]);
+          heap.push(item(dv, v));
+        }
+      }
+    }
+  }
+  this->buildMs = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count();
+}
+
+size_t DistanceNetwork::memory_bytes() const {
+  return this->dist.size() * sizeof(float) + this->via.size() * sizeof(int32_t);
+}
+
+DistanceNetwork::Decoded
+DistanceNetwork::decode(const std::vector<int> &keys, Scratch &s) const {
+  const size_t k = keys.size();
+  Decoded out{0.0f, 0};
+  s.best.assign(k, INFINITY);
+  s.from.assign(k, -1);
+  s.pending.resize(k);
+  std::iota(s.pending.begin(), s.pending.end(), 0);
+  if (s.stamp.size() != this->edges.size() or ++s.round == 0) {
+    s.stamp.assign(this->edges.size(), 0);
+    s.round = 1;
+  }
+  s.edges.clear();
+
+  // Prim no fecho métrico das chaves, expandindo cada aresta escolhida no
+  // seu caminho mínimo (as arestas repetidas entram uma vez só). A chave
+  // mais próxima é escolhida na mesma passada que atualiza as distâncias
+  size_t pick = 0;
+  while (!s.pending.empty()) {
+    const int next = s.pending[pick];
+    s.pending[pick] = s.pending.back();
+    s.pending.pop_back();
+
+    if (s.from[next] < 0) {
+      out.components++;
+    } else {
+      const size_t source = size_t(keys[s.from[next]]);
+      const int32_t *edge = &this->via[source * this->n];
+      for (int v = keys[next]; size_t(v) != source; ) {
+        const int32_t e = edge[v];
+        if (s.stamp[e] != s.round) {
+          s.stamp[e] = s.round;
+          s.edges.push_back(e);
+        }
+        v = this->edges[e].first == v ? this->edges[e].second : this->edges[e].first;
+      }
+    }
+
+    const float *row = &this->dist[size_t(keys[next]) * this->n];
+    float nearest = INFINITY;
+    pick = 0;
+    for (size_t p = 0; p < s.pending.size(); p++) {
+      const int i = s.pending[p];
+      const float d = row[keys[i]];
+      if (d < s.best[i]) {
+        s.best[i] = d;
+        s.from[i] = next;
+      }
+      if (s.best[i] < nearest) {
+        nearest = s.best[i];
+        pick = p;
+      }
+    }
+  }
+
+  // Árvore geradora mínima do subgrafo induzido pelos vértices dos caminhos
+  if (s.degree.size() != this->n) {
+    s.degree.assign(this->n, 0);
+    s.incident.assign(this->n, 0);
+    s.onPath.assign(this->n, false);
+  }
+  size_t onPath = 0;
+  for (int e : s.edges) {
+    for (int v : {this->edges[e].first, this->edges[e].second}) {
+      if (!s.onPath[v]) {
+        s.onPath[v] = true;
+        onPath++;
+      }
+    }
+  }
+  s.forest.tree.clear();
+  if (onPath > 0) this->mst(s.forest, &s.onPath, onPath);
+  for (int e : s.edges) {
+    s.onPath[this->edges[e].first] = s.onPath[this->edges[e].second] = false;
+  }
+  s.tree.swap(s.forest.tree);
+  for (int e : s.tree) s.stamp[e] = s.round;
+
+  // Poda das folhas não terminais: o xor das arestas ainda incidentes em um
+  // vértice de grau 1 é a sua única aresta
+  for (int e : s.tree) {
+    for (int v : {this->edges[e].first, this->edges[e].second}) {
+      s.degree[v]++;
+      s.incident[v] ^= e;
+    }
+  }
+  std::vector<int> &leaves = s.edges;
+  leaves.clear();
+  for (int e : s.tree) {
+    for (int v : {this->edges[e].first, this->edges[e].second}) {
+      if (s.degree[v] == 1 and !this->terminal[v]) leaves.push_back(v);
+    }
+  }
+  while (!leaves.empty()) {
+    const int v = leaves.back();
+    leaves.pop_back();
+    if (s.degree[v] != 1) continue;
+    const int e = s.incident[v];
+    const int u = this->edges[e].first == v ? this->edges[e].second : this->edges[e].first;
+    s.degree[v] = 0;
+    s.incident[v] = 0;
+    s.degree[u]--;
+    s.incident[u] ^= e;
+    s.stamp[e] = 0;  // fora da árvore
+    if (s.degree[u] == 1 and !this->terminal[u]) leaves.push_back(u);
+  }
+
+  size_t kept = 0;
+  for (int e : s.tree) {
+    for (int v : {this->edges[e].first, this->edges[e].second}) {
+      s.degree[v] = 0;
+      s.incident[v] = 0;
+    }
+    if (s.stamp[e] == 0) continue;
+    s.tree[kept++] = e;
+    out.cost += this->weights[e];
+  }
+  s.tree.resize(kept);
+  return out;
+}
+
+} // namespace steiner
@@ -0,0 +1,90 @@
+#ifndef STEINERTREE_DISTANCE_NETWORK_H
+#define STEINERTREE_DISTANCE_NETWORK_H
+
+#include <cstdint>
+#include <vector>
+#include "reductions.h"
+#include "minimum_spanning_tree.h"
+
+namespace steiner {
+
+/**
+ * @struct CSRGraph
+ * Adjacências em formato CSR (compressed sparse row): os vizinhos de v são
+ * targets[offsets[v]] ... targets[offsets[v + 1] - 1], e edge_ids guarda o
+ * índice da aresta na Instance de cada entrada.
+ */
+struct CSRGraph {
+  std::vector<uint32_t> offsets;
+  std::vector<uint32_t> targets;
+  std::vector<uint32_t> edge_ids;
+  std::vector<float> weights;
+
+  explicit CSRGraph(const Instance &instance);
+
+  size_t num_nodes() const { return this->offsets.size() - 1; }
+};
+
+/**
+ * @class DistanceNetwork
+ * Decodificador pela heurística da rede de distâncias (distance network
+ * heuristic, KMB): os terminais e os vértices escolhidos pelo cromossomo são
+ * ligados pela árvore geradora mínima do fecho métrico entre eles, cada
+ * aresta do fecho é expandida no seu caminho mínimo, e a árvore geradora
+ * mínima do subgrafo induzido pelos vértices desses caminhos tem as folhas
+ * não terminais podadas.
+ *
+ * Os caminhos mínimos entre todos os pares são calculados uma vez (Dijkstra
+ * a partir de cada vértice sobre o CSRGraph) e depois só lidos, então a
+ * mesma rede pode ser compartilhada entre avaliadores de várias threads,
+ * cada um com o seu Scratch.
+ */
+class DistanceNetwork {
+public:
+  /**
+   * Memória de trabalho de uma decodificação, reaproveitada entre chamadas.
+   * Depois de decode, `tree` tem as arestas (índices da Instance) da árvore */
+  struct Scratch {
+    std::vector<float> best;
+    std::vector<int> from;
+    std::vector<int> pending;     // chaves ainda fora da árvore do fecho
+    std::vector<uint32_t> stamp;  // marca das arestas já usadas
+    uint32_t round = 0;
+    std::vector<int> edges, degree, incident, tree;
+    std::vector<bool> onPath;
+    MinimumSpanningTree::Scratch forest;
+  };
+
+  // Custo da árvore e número de componentes (mais de 1 se houver chaves
+  // inalcançáveis umas a partir das outras)
+  struct Decoded {
+    float cost;
+    size_t components;
+  };
+
+  explicit DistanceNetwork(const Instance &instance);
+
+  float distance(int u, int v) const { return this->dist[size_t(u) * this->n + v]; }
+
+  /**
+   * Árvore de Steiner que liga os vértices `keys` (todos os terminais e os
+   * vértices de Steiner escolhidos) */
+  Decoded decode(const std::vector<int> &keys, Scratch &scratch) const;
+
+  double build_ms() const { return this->buildMs; }
+  size_t memory_bytes() const;
+
+private:
+  size_t n;
+  std::vector<edge_t> edges;
+  std::vector<float> weights;
+  std::vector<bool> terminal;
+  MinimumSpanningTree mst;       // arestas do grafo já ordenadas por peso
+  std::vector<float> dist;       // n x n, linha = origem
+  std::vector<int32_t> via;      // n x n, aresta que chega a v no caminho da origem
+  double buildMs = 0.0;
+};
+
+} // namespace steiner
+
+#endif //STEINERTREE_DISTANCE_NETWORK_H
@@ -1,21 +1,64 @@
 #include "minimum_spanning_tree.h"
+#include <algorithm>
+#include <numeric>
 
-std::pair<std::vector<steiner::Edge>, float>
-KruskalMST(unsigned int num_nodes, unsigned int num_edges, edge_t edges[], float weights[]) {
-  using namespace boost;
-  using steiner::Graph;
-  using steiner::Edge;
+namespace steiner {
 
-  Graph g(edges, edges + num_edges, weights, num_nodes);
-  property_map<Graph, edge_weight_t>::type weightof = get(edge_weight, g);
-  std::vector<Edge> spanning_tree;
+void UnionFind::reset(size_t n) {
+  if (this->parent.size() < n) {
+    this->parent.resize(n);
+    this->size.resize(n);
+  }
+  std::iota(this->parent.begin(), this->parent.begin() + n, 0);
+  std::fill(this->size.begin(), this->size.begin() + n, 1);
+}
+
+bool UnionFind::unite(int u, int v) {
+  u = this->find(u);
+  v = this->find(v);
+  if (u == v) return false;
+  if (this->size[u] < this->size[v]) std::swap(u, v);
+  this->parent[v] = u;
+  this->size[u] += this->size[v];
+  return true;
+}
 
-  kruskal_minimum_spanning_tree(g, std::back_inserter(spanning_tree));
-  float total_weight = 0;
+MinimumSpanningTree::MinimumSpanningTree(unsigned int num_nodes,
+    const std::vector<edge_t> &edges, const std::vector<float> &weights_)
+  : numNodes(num_nodes) {
+  std::vector<uint32_t> order(edges.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&weights_](uint32_t a, uint32_t b) {
+    return weights_[a] < weights_[b];
+  });
 
-  for (auto edge : spanning_tree) {
-    total_weight += weightof(edge);
+  this->from.reserve(order.size());
+  this->to.reserve(order.size());
+  this->weights.reserve(order.size());
+  for (uint32_t e : order) {
+    this->from.push_back(uint32_t(edges[e].first));
+    this->to.push_back(uint32_t(edges[e].second));
+    this->weights.push_back(weights_[e]);
   }
+  this->ids = std::move(order);
+}
+
+float MinimumSpanningTree::operator()(Scratch &scratch,
+    const std::vector<bool> *active, size_t num_active) const {
+  scratch.sets.reset(this->numNodes);
+  scratch.tree.clear();
+  const size_t target = num_active > 0 ? num_active - 1 : this->numNodes;
+  float cost = 0;
 
-  return std::pair<std::vector<Edge>, float>(spanning_tree, total_weight);
+  for (size_t i = 0; i < this->ids.size() and scratch.tree.size() < target; i++) {
+    const uint32_t u = this->from[i], v = this->to[i];
+    if (active and !((*active)[u] and (*active)[v])) continue;
+    if (scratch.sets.unite(int(u), int(v))) {
+      scratch.tree.push_back(int(this->ids[i]));
+      cost += this->weights[i];
+    }
+  }
+  return cost;
 }
+
+} // namespace steiner
@@ -1,18 +1,72 @@
 #ifndef STEINERTREE_MINIMUM_SPANNING_TREE_H
 #define STEINERTREE_MINIMUM_SPANNING_TREE_H
 
-#include <iostream>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <utility>
-#include <boost/graph/kruskal_min_spanning_tree.hpp>
-#include "graph.h"
 
 using edge_t = std::pair<int, int>;
 
-// Kruskal algorithm returns the total cost of the edges selected in minimum spanning tree.
-// Returns a pair where the first element is the set of edge which defines the spanning tree
-// and the second element is the sum of the weights of these edges.
-std::pair<std::vector<steiner::Edge>, float>
-KruskalMST(unsigned int num_nodes, unsigned int num_edges, edge_t edges[], float weights[]);
+namespace steiner {
+
+/**
+ * @struct UnionFind
+ * Conjuntos disjuntos com compressão de caminho (path halving) e união por
+ * tamanho. O vetor é reaproveitado entre chamadas: reset só reinicia os
+ * primeiros n vértices.
+ */
+struct UnionFind {
+  std::vector<int> parent, size;
+
+  void reset(size_t n);
+
+  int find(int v) {
+    while (this->parent[v] != v) v = this->parent[v] = this->parent[this->parent[v]];
+    return v;
+  }
+
+  // Une os conjuntos de u e v; false se já eram o mesmo
+  bool unite(int u, int v);
+};
+
+/**
+ * @class MinimumSpanningTree
+ * Kruskal sobre uma lista de arestas fixa, ordenada por peso uma única vez
+ * na construção e guardada em vetores paralelos (origem, destino, peso,
+ * índice) percorridos em sequência. Cada chamada só reinicia o UnionFind do
+ * Scratch, pula as arestas com algum vértice inativo e para quando a árvore
+ * tem (vértices ativos - 1) arestas.
+ *
+ * O objeto não muda depois de construído; a memória de trabalho fica no
+ * Scratch de quem chama.
+ */
+class MinimumSpanningTree {
+public:
+  struct Scratch {
+    UnionFind sets;
+    std::vector<int> tree;  // índices (na lista original) das arestas
+  };
+
+  MinimumSpanningTree(unsigned int num_nodes, const std::vector<edge_t> &edges,
+      const std::vector<float> &weights);
+
+  /**
+   * Custo da floresta geradora mínima do subgrafo induzido pelos vértices
+   * com active[v] (todos, se active for nulo). `num_active` é o número de
+   * vértices ativos, usado para parar cedo (0 = não parar). As arestas
+   * escolhidas ficam em scratch.tree */
+  float operator()(Scratch &scratch, const std::vector<bool> *active = nullptr,
+      size_t num_active = 0) const;
+
+  unsigned int num_nodes() const { return this->numNodes; }
+
+private:
+  unsigned int numNodes;
+  std::vector<uint32_t> from, to, ids;  // arestas em ordem de peso
+  std::vector<float> weights;
+};
+
+} // namespace steiner
 
 #endif //STEINERTREE_MINIMUM_SPANNING_TREE_H
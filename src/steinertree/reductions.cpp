@@ -0,0 +1,171 @@
+#include "reductions.h"
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <queue>
+#include <sstream>
+#include <utility>
+
+namespace steiner {
+
+namespace {
+
+/**
+ * Grafo mutável usado durante as reduções: cada vértice guarda um mapa
+ * vizinho -> aresta, então não há arestas paralelas */
+struct WorkGraph {
+  struct edge { int u, v; float weight; std::vector<int> path; bool alive; };
+
+  std::vector<std::map<int, size_t>> adj;
+  std::vector<edge> edges;
+  std::vector<bool> alive;
+
+  explicit WorkGraph(const Instance &instance)
+    : adj(instance.num_nodes), alive(instance.num_nodes, true) {
+    for (size_t e = 0; e < instance.edges.size(); e++) {
+      this->add(instance.edges[e].first, instance.edges[e].second,
+          instance.weights[e], instance.paths[e]);
+    }
+  }
+
+  // Adiciona {u, v} ou só barateia a aresta existente
+  void add(int u, int v, float weight, std::vector<int> path) {
+    if (u == v) return;
+    auto it = this->adj[u].find(v);
+    if (it != this->adj[u].end()) {
+      edge &old = this->edges[it->second];
+      if (old.weight > weight) {
+        old.weight = weight;
+        old.path = std::move(path);
+      }
+      return;
+    }
+    this->adj[u][v] = this->adj[v][u] = this->edges.size();
+    this->edges.push_back(edge{u, v, weight, std::move(path), true});
+  }
+
+  void remove_edge(size_t e) {
+    this->edges[e].alive = false;
+    this->adj[this->edges[e].u].erase(this->edges[e].v);
+    this->adj[this->edges[e].v].erase(this->edges[e].u);
+  }
+
+  void remove_node(int v) {
+    while (!this->adj[v].empty()) this->remove_edge(this->adj[v].begin()->second);
+    this->alive[v] = false;
+  }
+
+  /**
+   * Existe caminho de u a v com custo <= limit que não usa a aresta `skip`? */
+  bool shorter_path(int u, int v, float limit, size_t skip,
+      std::vector<float> &dist, std::vector<int> &touched) const {
+    using item = std::pair<float, int>;
+    std::priority_queue<item, std::vector<item>, std::greater<item>> heap;
+    dist[u] = 0;
+    touched.push_back(u);
+    heap.push(item(0, u));
+    bool found = false;
+    while (!heap.empty() and !found) {
+      auto [d, x] = heap.top();
+      heap.pop();
+      if (d > dist[x]) continue;
+      for (auto [y, e] : this->adj[x]) {
+        if (e == skip) continue;
+        const float dy = d + this->edges[e].weight;
+        if (dy > limit or dy >= dist[y]) continue;
+        if (y == v) {
+          found = true;
+          break;
+        }
+        if (dist[y] == INFINITY) touched.push_back(y);
+        dist[y] = dy;
+        heap.push(item(dy, y));
+      }
+    }
+    for (int x : touched) dist[x] = INFINITY;
+    touched.clear();
+    return found;
+  }
+};
+
+} // namespace
+
+std::string ReductionStats::to_string() const {
+  std::stringstream ss;
+  ss << this->leaves << " folhas, " << this->contracted << " caminhos contraídos, "
+     << this->long_edges << " arestas longas em " << this->ms << " ms";
+  return ss.str();
+}
+
+ReductionStats reduce(Instance &instance, bool leaves, bool paths,
+    bool longEdges) {
+  auto start = std::chrono::steady_clock::now();
+  ReductionStats stats;
+  WorkGraph graph(instance);
+  const int n = int(instance.num_nodes);
+  std::vector<float> dist(n, INFINITY);
+  std::vector<int> touched;
+
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (int v = 0; v < n; v++) {
+      if (!graph.alive[v] or instance.terminal[v]) continue;
+      const size_t degree = graph.adj[v].size();
+      if (leaves and degree <= 1) {
+        graph.remove_node(v);
+        stats.leaves++;
+        changed = true;
+      } else if (paths and degree == 2) {
+        auto first = graph.adj[v].begin(), second = std::next(first);
+        const int u = first->first, w = second->first;
+        const WorkGraph::edge &a = graph.edges[first->second];
+        const WorkGraph::edge &b = graph.edges[second->second];
+        std::vector<int> path(a.path);
+        path.push_back(instance.original[v]);
+        path.insert(path.end(), b.path.begin(), b.path.end());
+        const float weight = a.weight + b.weight;
+        graph.remove_node(v);
+        graph.add(u, w, weight, std::move(path));
+        stats.contracted++;
+        changed = true;
+      }
+    }
+    if (!longEdges) continue;
+    // As arestas são testadas no grafo corrente, uma de cada vez, então o
+    // caminho alternativo de uma aresta removida continua existindo
+    for (size_t e = 0; e < graph.edges.size(); e++) {
+      const WorkGraph::edge &edge = graph.edges[e];
+      if (!edge.alive) continue;
+      if (graph.shorter_path(edge.u, edge.v, edge.weight, e, dist, touched)) {
+        graph.remove_edge(e);
+        stats.long_edges++;
+        changed = true;
+      }
+    }
+  }
+
+  // Renumeração dos vértices restantes
+  std::vector<int> index(n, -1);
+  Instance reduced;
+  for (int v = 0; v < n; v++) {
+    if (!graph.alive[v]) continue;
+    index[v] = int(reduced.num_nodes++);
+    reduced.original.push_back(instance.original[v]);
+    reduced.terminal.push_back(instance.terminal[v]);
+  }
+  for (WorkGraph::edge &edge : graph.edges) {
+    if (!edge.alive) continue;
+    reduced.edges.emplace_back(index[edge.u], index[edge.v]);
+    reduced.weights.push_back(edge.weight);
+    reduced.paths.push_back(std::move(edge.path));
+  }
+  instance = std::move(reduced);
+
+  stats.ms = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count();
+  return stats;
+}
+
+} // namespace steiner
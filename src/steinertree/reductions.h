@@ -0,0 +1,52 @@
+#ifndef STEINERTREE_REDUCTIONS_H
+#define STEINERTREE_REDUCTIONS_H
+
+#include <string>
+#include <vector>
+#include "minimum_spanning_tree.h"
+
+namespace steiner {
+
+/**
+ * @struct Instance
+ * Grafo de uma instância do problema da árvore de Steiner com vértices a
+ * partir de 0. Depois das reduções um vértice pode representar um vértice
+ * diferente da instância original (`original`) e uma aresta pode representar
+ * um caminho contraído, cujos vértices internos ficam em `paths`.
+ */
+struct Instance {
+  unsigned int num_nodes = 0;
+  std::vector<edge_t> edges;
+  std::vector<float> weights;
+  std::vector<std::vector<int>> paths; // vértices originais internos da aresta
+  std::vector<int> original;           // vértice original de cada vértice
+  std::vector<bool> terminal;
+};
+
+/**
+ * Quantidade de reduções aplicadas por tipo */
+struct ReductionStats {
+  size_t leaves = 0;     // não terminais de grau 0 ou 1 removidos
+  size_t contracted = 0; // não terminais de grau 2 contraídos
+  size_t long_edges = 0; // arestas eliminadas pelo teste de caminho mínimo
+  double ms = 0.0;
+
+  std::string to_string() const;
+};
+
+/**
+ * Reduções que preservam ao menos uma árvore de Steiner ótima, aplicadas
+ * repetidamente até nenhuma mudar o grafo:
+ * - leaves: um não terminal de grau 1 nunca está em uma árvore ótima;
+ * - paths: um não terminal de grau 2 com vizinhos u e w é trocado por uma
+ *   aresta {u, w} com a soma dos pesos (ou some, se {u, w} já for mais
+ *   barata), guardando o vértice no caminho da aresta;
+ * - long_edges: uma aresta {u, v} de peso c é removida quando há outro
+ *   caminho entre u e v de custo <= c (Dijkstra limitado a c).
+ * No fim os vértices restantes são renumerados a partir de 0. */
+ReductionStats reduce(Instance &instance, bool leaves, bool paths,
+    bool longEdges);
+
+} // namespace steiner
+
+#endif //STEINERTREE_REDUCTIONS_H
@@ -1,4 +1,9 @@
 #include "steiner_tree.h"
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <core/ga/crossover_fabric.h>
 
 SteinerTreeProblem::SteinerTreeProblem(const char* filename) {
   this->instanceFilename = (char*) filename;
@@ -14,82 +19,161 @@ SteinerTreeProblem::SteinerTreeProblem(const char* filename) {
     std::vector<std::string> file_content_vec = split(*file_content, ' ');
     std::vector<float> file_content_numbers = convert_vec(file_content_vec);
     file.close();
+    delete file_content;
 
     // Lendo as quantidades e tamanhos
     uint index = 0;
-    this->num_nodes = file_content_numbers[index++]; // 0 -> 1
-    this->num_edges = file_content_numbers[index++]; // 1 -> 2
-    // this->num_steiner_nodes = file_content_numbers[2 + 3*num_edges];
-
-    // Criação dos arrays
-    this->nodes_vec_ptr = new std::vector<int>(num_nodes);
-    this->weights_vec_ptr = new std::vector<float>();
-    this->edges_vec_ptr = new std::vector<edge_t>();
-
-    // Atribuindo os valores aos arrays de arestas e pesos
-    for (; index < this->num_edges*3; index+=3) {
-      this->edges_vec_ptr->emplace_back(
-        edge_t(file_content_numbers[index], file_content_numbers[index+1])
+    this->instance.num_nodes = file_content_numbers[index++]; // 0 -> 1
+    uint num_edges = file_content_numbers[index++];           // 1 -> 2
+
+    // Atribuindo os valores aos arrays de arestas e pesos (vértices a
+    // partir de 0)
+    for (; index < num_edges*3; index+=3) {
+      this->instance.edges.emplace_back(
+        edge_t(file_content_numbers[index] - 1, file_content_numbers[index+1] - 1)
       );
-      this->weights_vec_ptr->emplace_back(file_content_numbers[index+2]);
+      this->instance.weights.emplace_back(file_content_numbers[index+2]);
     }
+    this->instance.paths.resize(this->instance.edges.size());
+    this->instance.original.resize(this->instance.num_nodes);
+    std::iota(this->instance.original.begin(), this->instance.original.end(), 0);
 
-    // Atribuindo os valores do array de vértices de Steiner
-    // index += 1; // pula o número de vértices de Steiner (já foi lido)
-    this->num_steiner_nodes = file_content_numbers[index];
-    //std::cout << "num_steiner_nodes = " << this->num_steiner_nodes << "\n";
-    this->steiner_nodes_vec_ptr = new std::vector<int>(num_steiner_nodes);
-    this->chromSize = this->num_steiner_nodes;
-    index += 1;
-
-    for (size_t i=0; i < this->steiner_nodes_vec_ptr->size(); i++) {
-      this->steiner_nodes_vec_ptr->at(i) = file_content_numbers[index];
-      index++;
+    // Terminais: a quantidade e em seguida os vértices
+    uint num_terminals = file_content_numbers[index++];
+    this->instance.terminal.assign(this->instance.num_nodes, false);
+    for (uint i = 0; i < num_terminals; i++, index++) {
+      this->instance.terminal.at(int(file_content_numbers[index]) - 1) = true;
     }
   }
+  this->set_candidates();
+}
+
+SteinerTreeProblem::~SteinerTreeProblem() = default;
+
+void SteinerTreeProblem::set_candidates() {
+  this->candidates.clear();
+  for (uint v = 0; v < this->instance.num_nodes; v++) {
+    if (!this->instance.terminal[v]) this->candidates.push_back(int(v));
+  }
+  this->chromSize = this->candidates.size();
+  // Mais caro que qualquer árvore: uma solução conexa sempre é melhor
+  this->penalty = std::accumulate(this->instance.weights.begin(),
+      this->instance.weights.end(), 1.0f);
+  this->mst.reset(new steiner::MinimumSpanningTree(this->instance.num_nodes,
+      this->instance.edges, this->instance.weights));
+}
+
+void SteinerTreeProblem::preprocess(const std::string &spec_) {
+  if (spec_.empty()) return;
+  // Mesmo formato de parâmetros dos operadores de crossover
+  const CrossoverSpec spec = CrossoverSpec::parse("preprocess:" + spec_);
+  spec.check_params({"leaves", "paths", "sd"});
+  const uint nodes = this->instance.num_nodes;
+  const size_t edges = this->instance.edges.size(), genes = this->chromSize;
+
+  steiner::ReductionStats stats = steiner::reduce(this->instance,
+      spec.get("leaves", 1) != 0, spec.get("paths", 1) != 0,
+      spec.get("sd", 1) != 0);
+  this->set_candidates();
+  if (this->network) {
+    this->network = std::make_shared<const steiner::DistanceNetwork>(this->instance);
+  }
+
+  std::stringstream report;
+  report << "Reduções: " << nodes << " -> " << this->instance.num_nodes
+         << " vértices, " << edges << " -> " << this->instance.edges.size()
+         << " arestas, " << genes << " -> " << this->chromSize
+         << " genes (" << stats.to_string() << ")";
+  this->reports.push_back(report.str());
 }
 
-SteinerTreeProblem::~SteinerTreeProblem() {
-  free(this->nodes_vec_ptr);
-  free(this->steiner_nodes_vec_ptr);
-  free(this->weights_vec_ptr);
-  free(this->edges_vec_ptr);
+void SteinerTreeProblem::set_decoder(const std::string &name) {
+  if (name.empty() or name == "mst") {
+    this->network.reset();
+  } else if (name == "dnh") {
+    this->network = std::make_shared<const steiner::DistanceNetwork>(this->instance);
+    std::stringstream report;
+    report << "Rede de distâncias: " << this->instance.num_nodes
+           << " vértices em " << this->network->build_ms() << " ms ("
+           << this->network->memory_bytes() / 1048576.0 << " MB)";
+    this->reports.push_back(report.str());
+  } else {
+    throw std::invalid_argument("Decodificador desconhecido: " + name
+        + " (use mst ou dnh)");
+  }
+}
+
+size_t SteinerTreeProblem::original_index(size_t gene) const {
+  return this->instance.original[this->candidates[gene]];
 }
 
 eoPop<Chrom> SteinerTreeProblem::init_pop(uint len, double bias) {
   return Random<Chrom>::population(this->chromSize, len, bias);
 }
 
-void SteinerTreeProblem::operator()(Chrom& chromosome) {
-  std::vector<edge_t> edges(*this->edges_vec_ptr);
-  std::vector<float> weights(*this->weights_vec_ptr);
-  int num_removed_nodes = 0;
-
+void SteinerTreeProblem::select(const Chrom& chromosome) {
+  this->active = this->instance.terminal;
+  this->numActive = this->instance.num_nodes - this->chromSize;
   for (uint i=0; i < this->chromSize; i++) {
-    if (!chromosome[i]) {
-      remove_node(edges, weights, this->steiner_nodes_vec_ptr->at(i));
-      num_removed_nodes++;
+    if (chromosome[i]) {
+      this->active[this->candidates[i]] = true;
+      this->numActive++;
     }
   }
-  int V = this->num_nodes - num_removed_nodes;
-  auto&& [mst_edges, mst_cost] = KruskalMST(V, num_edges, &edges[0], &weights[0]);
+}
 
-  chromosome.fitness(1 / mst_cost);
+float SteinerTreeProblem::spanning_tree(const Chrom& chromosome) {
+  this->select(chromosome);
+  return (*this->mst)(this->forest, &this->active, this->numActive);
 }
 
-void
-SteinerTreeProblem::remove_node(std::vector<edge_t>& edges,
-    std::vector<float>& weights, int node)
-{
-  for (std::size_t i=0; i < edges.size(); i++) {
-    if (edges[i].first == node or edges[i].second == node) {
-      edges.erase(edges.begin()+i);
-      weights.erase(weights.begin()+i);
-      i--;
-    }
+steiner::DistanceNetwork::Decoded
+SteinerTreeProblem::distance_network_tree(const Chrom& chromosome) {
+  this->select(chromosome);
+  this->keys.clear();
+  for (uint v = 0; v < this->instance.num_nodes; v++) {
+    if (this->active[v]) this->keys.push_back(int(v));
   }
+  return this->network->decode(this->keys, this->scratch);
 }
 
-std::vector<int> *const SteinerTreeProblem::steiner_nodes() {
-  return this->steiner_nodes_vec_ptr;
+void SteinerTreeProblem::operator()(Chrom& chromosome) {
+  if (this->network) {
+    auto [cost, components] = this->distance_network_tree(chromosome);
+    chromosome.fitness(1 / (cost + this->penalty * (components - 1)));
+    return;
+  }
+  const float cost = this->spanning_tree(chromosome);
+
+  // Uma floresta com k componentes tem (vértices - k) arestas
+  const size_t components = this->numActive - this->forest.tree.size();
+  chromosome.fitness(1 / (cost + this->penalty * (components - 1)));
+}
+
+std::vector<int> SteinerTreeProblem::tree_nodes(const Chrom& chromosome) {
+  // Arestas da árvore, como índices da Instance
+  std::vector<int> tree;
+  if (this->network) {
+    this->distance_network_tree(chromosome);
+    tree = this->scratch.tree;
+  } else {
+    this->spanning_tree(chromosome);
+    tree = this->forest.tree;
+  }
+
+  std::vector<int> nodes;
+  std::vector<bool> in_tree(this->instance.num_nodes, false);
+  for (int e : tree) {
+    const edge_t &edge = this->instance.edges[e];
+    in_tree[edge.first] = in_tree[edge.second] = true;
+    const std::vector<int> &path = this->instance.paths[e];
+    nodes.insert(nodes.end(), path.begin(), path.end());
+  }
+  for (int v : this->candidates) {
+    if (in_tree[v]) nodes.push_back(this->instance.original[v]);
+  }
+
+  for (int &v : nodes) v++;
+  std::sort(nodes.begin(), nodes.end());
+  return nodes;
 }
@@ -2,13 +2,26 @@
 #define STEINER_TREE_PROBLEM_H
 
 #include <fstream>
+#include <memory>
 #include <string>
 #include <core/utils/split.h>
 #include <core/utils/vectors.h>
 #include <core/ga/problem.h>
 #include <core/ga/random.h>
 #include "minimum_spanning_tree.h"
+#include "reductions.h"
+#include "distance_network.h"
 
+/**
+ * Problema da árvore de Steiner em grafos (instâncias da OR-Library: número
+ * de vértices e arestas, as arestas "u v peso" e por fim os terminais). Cada
+ * gene diz se um vértice não terminal (candidato a vértice de Steiner) entra
+ * na árvore; o custo é o da árvore geradora mínima do subgrafo induzido
+ * pelos terminais e candidatos escolhidos, mais uma penalidade por
+ * componente desconexa. Com o decodificador "dnh" o custo é o da árvore da
+ * heurística da rede de distâncias (steiner::DistanceNetwork) sobre os
+ * mesmos vértices.
+ */
 class SteinerTreeProblem : public Problem {
 public:
   SteinerTreeProblem(const char* filename);
@@ -17,19 +30,67 @@ public:
   eoPop<Chrom> init_pop(uint len, double _bias = 0.5);
   void operator()(Chrom& chromosome);
 
-  std::vector<int> *const steiner_nodes();
+  /**
+   * Reduções do grafo: "leaves=1,paths=1,sd=1" (ver steiner::reduce). O
+   * cromossomo passa a ter só os candidatos que restaram */
+  void preprocess(const std::string &spec);
 
-  // Remover todas as arestas adjacentes a um conjunto de vértices
-  void remove_node(std::vector<edge_t>& edges, std::vector<float>& weights, int node);
+  /**
+   * "mst" (padrão): árvore geradora mínima do subgrafo induzido; "dnh":
+   * heurística da rede de distâncias, com os caminhos mínimos calculados
+   * aqui (e de novo se um preprocess reduzir o grafo depois) */
+  void set_decoder(const std::string &name);
+
+  // Rede do decodificador "dnh" (nula com "mst"). Outra cópia do problema
+  // sobre a mesma instância pode usá-la sem recalcular os caminhos
+  std::shared_ptr<const steiner::DistanceNetwork> get_distance_network() const {
+    return this->network;
+  }
+  void set_distance_network(std::shared_ptr<const steiner::DistanceNetwork> net) {
+    this->network = std::move(net);
+  }
+
+  // Cópia com os próprios buffers de avaliação, que compartilha as arestas
+  // ordenadas e a rede de distâncias com este problema
+  Problem *clone_evaluator() const { return new SteinerTreeProblem(*this); }
+
+  // Vértice original (a partir de 0) representado por um gene
+  size_t original_index(size_t gene) const;
+
+  /**
+   * Vértices de Steiner (ids originais, a partir de 1) da árvore definida
+   * pelo cromossomo, incluindo os vértices de caminhos contraídos pelas
+   * reduções que fazem parte dela */
+  std::vector<int> tree_nodes(const Chrom &chromosome);
+
+  const steiner::Instance &get_instance() const { return this->instance; }
 
 private:
-  uint num_nodes;                          // Número de vértices
-  uint num_edges;                          // Número de arestas
-  uint num_steiner_nodes;                  // Número de vértices de Steiner
-  std::vector<int> *nodes_vec_ptr;         // Ponteiro para vector de vértices
-  std::vector<int> *steiner_nodes_vec_ptr; // Ponteiro para vector de vértices de Steiner
-  std::vector<float> *weights_vec_ptr;     // Ponteiro para vector de pesos das arestas
-  std::vector<edge_t> *edges_vec_ptr;      // Ponteiro para vector de pares de inteiros (arestas)
+  steiner::Instance instance;   // grafo corrente (reduzido ou não)
+  std::vector<int> candidates;  // vértice do grafo de cada gene
+  float penalty;                // custo de cada componente além da primeira
+  std::vector<bool> active;     // vértices do subgrafo avaliado
+  size_t numActive;
+  // Arestas já ordenadas (só leitura, compartilhadas com as cópias)
+  std::shared_ptr<const steiner::MinimumSpanningTree> mst;
+  steiner::MinimumSpanningTree::Scratch forest;
+  // Caminhos mínimos do decodificador "dnh" (só leitura, compartilháveis)
+  std::shared_ptr<const steiner::DistanceNetwork> network;
+  steiner::DistanceNetwork::Scratch scratch;
+  std::vector<int> keys;        // terminais e candidatos escolhidos
+
+  // Define os genes, a penalidade e o Kruskal a partir do grafo corrente
+  void set_candidates();
+
+  // Marca em `active` os terminais e os candidatos escolhidos
+  void select(const Chrom &chromosome);
+
+  // Árvore geradora mínima do subgrafo induzido pelo cromossomo (as arestas
+  // ficam em forest.tree)
+  float spanning_tree(const Chrom &chromosome);
+
+  // Árvore do decodificador "dnh" (as arestas ficam em scratch.tree)
+  steiner::DistanceNetwork::Decoded distance_network_tree(const Chrom &chromosome);
 };
 
 #endif
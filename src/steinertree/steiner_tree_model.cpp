@@ -8,15 +8,16 @@ SteinerTreeModel::SteinerTreeModel(CLI *cli)
 : db::BaseModel("steiner_executions"), num_steiner_nodes(int()),
   steiner_nodes(std::string()), total_costs(float())
 {
-  this->crossover_id = cli->crossover_id;
+  this->set_crossover(cli->crossover);
   this->crossover_rate = cli->crossover_rate;
-  this->crossover_name = CrossoverFabric::name(this->crossover_id);
   this->mutation_rate = cli->mutation_rate;
   this->stop_criteria = cli->stop_criteria;
   this->population_size = cli->pop_size;
 }
 
-void SteinerTreeModel::set_solution_data(std::vector<int>& solutionNodes) {
+void SteinerTreeModel::set_solution_data(SteinerTreeProblem &problem,
+    const Chrom &best) {
+  std::vector<int> solutionNodes = problem.tree_nodes(best);
   this->num_steiner_nodes = int(solutionNodes.size());
   this->steiner_nodes = db::BaseModel::sequence_to_string<int>(solutionNodes);
 }
@@ -34,6 +35,18 @@ void SteinerTreeModel::create(sqlite::connection *con) {
   sql += "instance_file TEXT, ";
   sql += "convergence TEXT, ";
   sql += "duration_in_ms REAL, ";
+  sql += "phase_times TEXT, ";
+  sql += "objective_calls INTEGER, ";
+  sql += "repair_calls INTEGER, ";
+  sql += "cache_hits INTEGER, ";
+  sql += "local_search_moves INTEGER, ";
+  sql += "operator_log TEXT, ";
+  sql += "rates TEXT, ";
+  sql += "restarts INTEGER, ";
+  sql += "stop_rule TEXT, ";
+  sql += "stop_reason TEXT, ";
+  sql += "time_to_target_ms REAL, ";
+  sql += "evals_to_target INTEGER, ";
   sql += "num_steiner_nodes INTEGER, ";
   sql += "steiner_nodes TEXT, ";
   sql += "total_costs REAL);";
@@ -43,6 +56,7 @@ void SteinerTreeModel::create(sqlite::connection *con) {
   std::cout << sql << std::endl;
 # endif
   sqlite::execute(*con, sql, true);
+  this->migrate(con);
 }
 
 void SteinerTreeModel::insert(sqlite::connection *con) {
@@ -50,8 +64,12 @@ void SteinerTreeModel::insert(sqlite::connection *con) {
   sql = "INSERT INTO " + std::string(this->table_name) + " (";
   sql += "population_size, stop_criteria, crossover, crossover_name, ";
   sql += "crossover_rate, mutation_rate, instance_file, convergence, ";
-  sql += "duration_in_ms, num_steiner_nodes, steiner_nodes, total_costs";
-  sql += ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
+  sql += "duration_in_ms, phase_times, objective_calls, repair_calls, ";
+  sql += "cache_hits, local_search_moves, operator_log, rates, restarts, ";
+  sql += "stop_rule, stop_reason, time_to_target_ms, evals_to_target, ";
+  sql += "num_steiner_nodes, steiner_nodes, total_costs";
+  sql += ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ";
+  sql += "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
 
 # ifdef NDEBUG
   std::cout << "Executando Query no banco:\n";
@@ -59,9 +77,13 @@ void SteinerTreeModel::insert(sqlite::connection *con) {
 # endif
 
   sqlite::execute ins(*con, sql);
-  ins % this->population_size   % this->stop_criteria   % this->crossover_id
-      % this->crossover_name    % this->crossover_rate  % this->mutation_rate
-      % this->instance_file     % this->convergence     % this->duration_in_ms
-      % this->num_steiner_nodes % this->steiner_nodes   % this->total_costs;
+  ins % this->population_size    % this->stop_criteria      % this->crossover_id
+      % this->crossover_name     % this->crossover_rate     % this->mutation_rate
+      % this->instance_file      % this->convergence        % this->duration_in_ms
+      % this->phase_times        % this->objective_calls    % this->repair_calls
+      % this->cache_hits         % this->local_search_moves % this->operator_log
+      % this->rates              % this->restarts           % this->stop_rule
+      % this->stop_reason        % this->time_to_target_ms  % this->evals_to_target
+      % this->num_steiner_nodes  % this->steiner_nodes      % this->total_costs;
   ins();  
 }
@@ -5,6 +5,7 @@
 #include <core/ga/crossover_fabric.h>
 #include <core/utils/trim_filename.h>
 #include <core/cli/options.h>
+#include "steiner_tree.h"
 
 class SteinerTreeModel : public db::BaseModel {
 public:
@@ -18,8 +19,10 @@ public:
 
   /**
    * @brief define os valores relacionados à solução obtida (numéro de vértices
-   * de Steiner; Os vértices de Steiner; custo total da árvore) */
-  void set_solution_data(std::vector<int>& solutionNodes);
+   * de Steiner; Os vértices de Steiner). Os genes do melhor cromossomo são
+   * convertidos para os vértices da instância original, incluindo os que
+   * as reduções esconderam em caminhos contraídos */
+  void set_solution_data(SteinerTreeProblem &problem, const Chrom &best);
 
   void create(sqlite::connection *con);
   void insert(sqlite::connection *con);